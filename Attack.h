@@ -49,6 +49,8 @@ public:
 	with ID bulletModelID.
 	*/
 	inline const bool usesBulletModel(int bulletModelID) const { return bulletModelsCount.count(bulletModelID) > 0 && bulletModelsCount.at(bulletModelID) > 0; }
+	// Returns a map of the IDs of every BulletModel this EditorAttack and its children EMPs use to the number of times it is used
+	inline const std::map<int, int>& getBulletModelIDCount() const { return bulletModelsCount; }
 	inline int getID() const { return id; }
 	inline std::string getName() const { return name; }
 	inline bool getPlayAttackAnimation() const { return playAttackAnimation; }
@@ -54,7 +54,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				[this, selectedAttack, oldName]() {
 				selectedAttack->setName(oldName);
 				setAttackWidgetValues(selectedAttack, true);
-			}));
+			}, text.capacity() + oldName.capacity()));
 		}
 	});
 	aiPlayAttackAnimation->connect("Changed", [this, &selectedAttack = this->selectedAttack]() {
@@ -69,7 +69,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				[this, selectedAttack, checked]() {
 				selectedAttack->setPlayAttackAnimation(!checked);
 				setAttackWidgetValues(selectedAttack, true);
-			}));
+			}, sizeof(checked)));
 		}
 	});
 
@@ -143,9 +143,10 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 		},
 			[this, &levelPack, newAttack]() {
 			deleteAttack(newAttack, true);
-		}));
+		}, newAttack->format().size()));
 	});
 	alDeleteAttack->connect("Pressed", [this, &levelPack = this->levelPack, &selectedAttack = this->selectedAttack]() {
+		// The deleted attack is kept alive only by the undo stack, so its formatted size is used as an estimate of its memory usage
 		mainWindowUndoStack.execute(UndoableCommand(
 			[this, selectedAttack]() {
 			deleteAttack(selectedAttack);
@@ -153,7 +154,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			[this, &levelPack, selectedAttack]() {
 			levelPack->updateAttack(selectedAttack);
 			buildAttackList(false);
-		}));
+		}, selectedAttack->format().size()));
 	});
 
 	alPanel->add(alList);
@@ -215,11 +216,12 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			}
 			emp->detachFromParent();
 			buildEMPTree();
-		}));
+		}, emp->format().size()));
 	});
 	emplDeleteEMP->connect("Pressed", [this, &selectedAttack = this->selectedAttack, &selectedEMP = this->selectedEMP]() {
 		// Can't delete main EMP of an attack
 		if (selectedEMP && selectedEMP->getID() != selectedAttack->getMainEMP()->getID()) {
+			// The deleted EMP and its children are kept alive only by the undo stack
 			mainWindowUndoStack.execute(UndoableCommand(
 				[this, selectedAttack, selectedEMP]() {
 				deleteEMP(selectedAttack, selectedEMP);
@@ -227,7 +229,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				[this, selectedEMP]() {
 				selectedEMP->getParent()->addChild(selectedEMP);
 				buildEMPTree();
-			}));
+			}, selectedEMP->format().size()));
 		}
 	});
 	emplTestEMP->connect("Pressed", [this, &selectedAttack = this->selectedAttack, &selectedEMP = this->selectedEMP]() {
@@ -384,7 +386,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				[this, selectedEMP, selectedAttack, checked]() {
 				selectedEMP->setIsBullet(!checked);
 				setEMPWidgetValues(selectedEMP, selectedAttack, false);
-			}));
+			}, sizeof(checked)));
 		}
 	});
 	empiHitboxRadius->getOnValueSet()->sink().connect<AttackEditor, &AttackEditor::onEmpiHitboxRadiusChange>(this);
@@ -428,7 +430,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			} else if (id == "2") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -441,7 +443,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false); buildEMPIActions();
-				}));
+				}, sizeof(index)));
 			} else if (id == "3") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -454,7 +456,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			} else if (id == "4") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -467,7 +469,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			} else if (id == "5") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -480,7 +482,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			}
 		});
 		mainWindow->addPopupWidget(empiPanel, popup);
@@ -516,7 +518,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			} else if (id == "2") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -529,7 +531,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false); buildEMPIActions();
-				}));
+				}, sizeof(index)));
 			} else if (id == "3") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -542,7 +544,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			} else if (id == "4") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -555,7 +557,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			} else if (id == "5") {
 				mainWindowUndoStack.execute(UndoableCommand(
 					[this, index, selectedEMP, selectedAttack]() {
@@ -568,7 +570,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 					[this, index, selectedEMP, selectedAttack]() {
 					selectedEMP->removeAction(index);
 					setEMPWidgetValues(selectedEMP, selectedAttack, false);
-				}));
+				}, sizeof(index)));
 			}
 		});
 		mainWindow->addPopupWidget(empiPanel, popup);
@@ -582,7 +584,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			[this, selectedEMP, selectedEMPAIndex, selectedEMPA]() {
 			selectedEMP->insertAction(selectedEMPAIndex, selectedEMPA);
 			buildEMPIActions();
-		}));
+		}, selectedEMPA->format().size()));
 	});
 
 	// See getID(EMPSpawnType*) for which ID to use
@@ -601,7 +603,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				[this, selectedEMP, selectedAttack, oldSpawnType]() {
 				selectedEMP->setSpawnType(oldSpawnType);
 				setEMPWidgetValues(selectedEMP, selectedAttack, false);
-			}));
+			}, oldSpawnType->format().size()));
 		} else if (id == "2") {
 			mainWindowUndoStack.execute(UndoableCommand(
 				[this, selectedEMP, selectedAttack]() {
@@ -611,7 +613,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				[this, selectedEMP, selectedAttack, oldSpawnType]() {
 				selectedEMP->setSpawnType(oldSpawnType);
 				setEMPWidgetValues(selectedEMP, selectedAttack, false);
-			}));
+			}, oldSpawnType->format().size()));
 		} else {
 			mainWindowUndoStack.execute(UndoableCommand(
 				[this, selectedEMP, selectedAttack]() {
@@ -621,7 +623,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				[this, selectedEMP, selectedAttack, oldSpawnType]() {
 				selectedEMP->setSpawnType(oldSpawnType);
 				setEMPWidgetValues(selectedEMP, selectedAttack, false);
-			}));
+			}, oldSpawnType->format().size()));
 		}
 	});
 	empiSpawnTypeTime->getOnValueSet()->sink().connect<AttackEditor, &AttackEditor::onEmpiSpawnTypeTimeChange>(this);
@@ -644,7 +646,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			[this, selectedEMP, selectedAttack, checked]() {
 			selectedEMP->setLoopAnimation(!checked);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked)));
 	});
 	empiBaseSprite->getOnValueSet()->sink().connect<AttackEditor, &AttackEditor::onBaseSpriteChange>(this);
 	empiDamage->getOnValueSet()->sink().connect<AttackEditor, &AttackEditor::onEmpiDamageChange>(this);
@@ -664,7 +666,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			[this, selectedEMP, selectedAttack, oldAction]() {
 			selectedEMP->setOnCollisionAction(oldAction);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(action) + sizeof(oldAction)));
 	});
 
 	empiPierceResetTime->getOnValueSet()->sink().connect<AttackEditor, &AttackEditor::onEmpiPierceResetTimeChange>(this);
@@ -710,7 +712,8 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 				selectedEMP->setBulletModel(levelPack->getBulletModel(oldBulletModelID));
 			}
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(bulletModelID) + sizeof(oldBulletModelID) + sizeof(radius) + sizeof(despawnTime) + sizeof(interval) + sizeof(lifespan)
+			+ animatable.format().size() + baseSprite.format().size() + sizeof(loopAnimation) + sizeof(damage) + sound.format().size()));
 	});
 	empiInheritRadius->connect("Changed", [this, levelPack, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack]() {
 		if (ignoreSignal) return;
@@ -726,7 +729,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			selectedEMP->setHitboxRadius(oldValue);
 			selectedEMP->setInheritRadius(!checked, *levelPack);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked) + sizeof(oldValue)));
 	});
 	empiInheritDespawnTime->connect("Changed", [this, levelPack, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack]() {
 		if (ignoreSignal) return;
@@ -742,7 +745,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			selectedEMP->setDespawnTime(oldValue);
 			selectedEMP->setInheritDespawnTime(!checked, *levelPack);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked) + sizeof(oldValue)));
 	});
 	empiInheritShadowTrailInterval->connect("Changed", [this, levelPack, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack]() {
 		if (ignoreSignal) return;
@@ -758,7 +761,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			selectedEMP->setShadowTrailInterval(oldValue);
 			selectedEMP->setInheritShadowTrailInterval(!checked, *levelPack);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked) + sizeof(oldValue)));
 	});
 	empiInheritShadowTrailLifespan->connect("Changed", [this, levelPack, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack]() {
 		if (ignoreSignal) return;
@@ -774,7 +777,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			selectedEMP->setShadowTrailLifespan(oldValue);
 			selectedEMP->setInheritShadowTrailLifespan(!checked, *levelPack);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked) + sizeof(oldValue)));
 	});
 	empiInheritAnimatables->connect("Changed", [this, levelPack, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack]() {
 		if (ignoreSignal) return;
@@ -796,7 +799,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			selectedEMP->setBaseSprite(oldBaseSprite);
 			selectedEMP->setInheritAnimatables(!checked, *levelPack);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked) + oldAnimatable.format().size() + oldBaseSprite.format().size() + sizeof(oldLoop)));
 	});
 	empiInheritDamage->connect("Changed", [this, levelPack, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack]() {
 		if (ignoreSignal) return;
@@ -812,7 +815,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			selectedEMP->setDamage(oldValue);
 			selectedEMP->setInheritDamage(!checked, *levelPack);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked) + sizeof(oldValue)));
 	});
 	empiInheritSoundSettings->connect("Changed", [this, levelPack, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack]() {
 		if (ignoreSignal) return;
@@ -828,7 +831,7 @@ AttackEditor::AttackEditor(std::shared_ptr<LevelPack> levelPack, std::shared_ptr
 			selectedEMP->setSoundSettings(oldValue);
 			selectedEMP->setInheritSoundSettings(!checked, *levelPack);
 			setEMPWidgetValues(selectedEMP, selectedAttack, false);
-		}));
+		}, sizeof(checked) + oldValue.format().size()));
 	});
 
 	empiBulletModel->removeAllItems();
@@ -1873,10 +1876,18 @@ void AttackEditor::onGameplayTestWindowBezierControlPointsEditingEnd(bool change
 			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &bezierEMPA = bezierEMPA, &selectedEMPA = selectedEMPA, oldControlPoints]() {
 			bezierEMPA->setUnrotatedControlPoints(oldControlPoints);
 			setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
-		}));
+		}, (newControlPoints.capacity() + oldControlPoints.capacity()) * sizeof(sf::Vector2f)));
 	}
 }
 
+std::string AttackEditor::getSliderCoalesceKey(std::string propertyName) {
+	std::string key = propertyName + "|" + std::to_string(selectedAttack->getID()) + "|" + std::to_string(selectedEMP->getID());
+	if (selectedEMPA) {
+		key += "|" + std::to_string(selectedEMPAIndex);
+	}
+	return key;
+}
+
 void AttackEditor::onEmpiHitboxRadiusChange(float value) {
 	if (ignoreSignal) return;
 	float oldValue = selectedEMP->getHitboxRadius();
@@ -1888,7 +1899,7 @@ void AttackEditor::onEmpiHitboxRadiusChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setHitboxRadius(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue), getSliderCoalesceKey("hitboxRadius")));
 }
 
 void AttackEditor::onEmpiDespawnTimeChange(float value) {
@@ -1902,7 +1913,7 @@ void AttackEditor::onEmpiDespawnTimeChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setDespawnTime(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue), getSliderCoalesceKey("despawnTime")));
 }
 
 void AttackEditor::onEmpiSpawnTypeTimeChange(float value) {
@@ -1916,7 +1927,7 @@ void AttackEditor::onEmpiSpawnTypeTimeChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->getSpawnType()->setTime(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue)));
 }
 
 void AttackEditor::onEmpiSpawnTypeXChange(float value) {
@@ -1930,7 +1941,7 @@ void AttackEditor::onEmpiSpawnTypeXChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->getSpawnType()->setX(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue)));
 }
 
 void AttackEditor::onEmpiSpawnTypeYChange(float value) {
@@ -1944,7 +1955,7 @@ void AttackEditor::onEmpiSpawnTypeYChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->getSpawnType()->setY(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue)));
 }
 
 void AttackEditor::onEmpiShadowTrailLifespanChange(float value) {
@@ -1958,7 +1969,7 @@ void AttackEditor::onEmpiShadowTrailLifespanChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setShadowTrailLifespan(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue), getSliderCoalesceKey("shadowTrailLifespan")));
 }
 
 void AttackEditor::onEmpiShadowTrailIntervalChange(float value) {
@@ -1972,7 +1983,7 @@ void AttackEditor::onEmpiShadowTrailIntervalChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setShadowTrailInterval(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue), getSliderCoalesceKey("shadowTrailInterval")));
 }
 
 void AttackEditor::onAnimatableChange(Animatable value) {
@@ -1991,7 +2002,7 @@ void AttackEditor::onAnimatableChange(Animatable value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setAnimatable(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, value.format().size() + oldValue.format().size()));
 }
 
 void AttackEditor::onBaseSpriteChange(Animatable value) {
@@ -2005,7 +2016,7 @@ void AttackEditor::onBaseSpriteChange(Animatable value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setBaseSprite(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, value.format().size() + oldValue.format().size()));
 }
 
 void AttackEditor::onEmpiDamageChange(float value) {
@@ -2019,7 +2030,7 @@ void AttackEditor::onEmpiDamageChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setDamage(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue)));
 }
 
 void AttackEditor::onEmpiSoundSettingsChange(SoundSettings value) {
@@ -2033,7 +2044,7 @@ void AttackEditor::onEmpiSoundSettingsChange(SoundSettings value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setSoundSettings(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, value.format().size() + oldValue.format().size()));
 }
 
 void AttackEditor::onEmpiPierceResetTimeChange(float value) {
@@ -2047,7 +2058,7 @@ void AttackEditor::onEmpiPierceResetTimeChange(float value) {
 		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, oldValue]() {
 		selectedEMP->setPierceResetTime(oldValue);
 		setEMPWidgetValues(selectedEMP, selectedAttack, false);
-	}));
+	}, sizeof(value) + sizeof(oldValue), getSliderCoalesceKey("pierceResetTime")));
 }
 
 void AttackEditorMainWindow::handleEvent(sf::Event event) {
@@ -2101,21 +2112,23 @@ void AttackEditor::onEmpaiDurationChange(float value) {
 		//TODO: add EMPAs to this if any other EMPAs also use TFVs
 
 		setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
-	}));
+	}, sizeof(value) + sizeof(oldValue), getSliderCoalesceKey("empaDuration")));
 }
 
 void AttackEditor::onEmpaiAngleOffsetChange(std::shared_ptr<EMPAAngleOffset> oldOffset, std::shared_ptr<EMPAAngleOffset> updatedOffset) {
 	std::shared_ptr<EMPAAngleOffset> copyOfOld = oldOffset->clone();
+	// Both copyOfOld and updatedOffset are kept alive only by the undo stack
+	size_t memoryUsage = copyOfOld->format().size() + updatedOffset->format().size();
 
 	mainWindowUndoStack.execute(UndoableCommand(
-		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, &oldOffset = oldOffset, updatedOffset]() {
+		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldOffset, updatedOffset]() {
 		*oldOffset = *updatedOffset;
 		setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
 	},
-		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, &oldOffset = oldOffset, copyOfOld]() {
+		[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldOffset, copyOfOld]() {
 		*oldOffset = *copyOfOld;
 		setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
-	}));
+	}, memoryUsage));
 }
 
 void AttackEditor::onTFVEditingStart() {
@@ -2137,11 +2150,12 @@ void AttackEditor::onTFVEditingEnd(std::shared_ptr<TFV> oldTFV, std::shared_ptr<
 }
 
 void AttackEditor::onTFVEditingSave(std::shared_ptr<TFV> oldTFV, std::shared_ptr<TFV> updatedTFV, std::string tfvIdentifier) {
-	std::shared_ptr<TFV> copyOfOld = oldTFV->clone();
+	// Only the old TFV's formatted string is kept, since it is much smaller than a copy of the TFV
+	std::string oldTFVFormat = oldTFV->format();
 	
 	if (dynamic_cast<MoveCustomPolarEMPA*>(selectedEMPA.get()) != nullptr) {
 		mainWindowUndoStack.execute(UndoableCommand(
-			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldTFV, updatedTFV, tfvIdentifier]() {
+			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, updatedTFV, tfvIdentifier]() {
 			if (tfvIdentifier == "distance") {
 				dynamic_cast<MoveCustomPolarEMPA*>(selectedEMPA.get())->setDistance(updatedTFV);
 			} else {
@@ -2149,17 +2163,17 @@ void AttackEditor::onTFVEditingSave(std::shared_ptr<TFV> oldTFV, std::shared_ptr
 			}
 			setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
 		},
-			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldTFV, copyOfOld, tfvIdentifier]() {
+			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldTFVFormat, tfvIdentifier]() {
 			if (tfvIdentifier == "distance") {
-				dynamic_cast<MoveCustomPolarEMPA*>(selectedEMPA.get())->setDistance(copyOfOld);
+				dynamic_cast<MoveCustomPolarEMPA*>(selectedEMPA.get())->setDistance(TFVFactory::create(oldTFVFormat));
 			} else {
-				dynamic_cast<MoveCustomPolarEMPA*>(selectedEMPA.get())->setAngle(copyOfOld);
+				dynamic_cast<MoveCustomPolarEMPA*>(selectedEMPA.get())->setAngle(TFVFactory::create(oldTFVFormat));
 			}
 			setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
-		}));
+		}, oldTFVFormat.capacity() + updatedTFV->format().size()));
 	} else if (dynamic_cast<MovePlayerHomingEMPA*>(selectedEMPA.get()) != nullptr) {
 		mainWindowUndoStack.execute(UndoableCommand(
-			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldTFV, updatedTFV, tfvIdentifier]() {
+			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, updatedTFV, tfvIdentifier]() {
 			if (tfvIdentifier == "homingStrength") {
 				dynamic_cast<MovePlayerHomingEMPA*>(selectedEMPA.get())->setHomingStrength(updatedTFV);
 			} else {
@@ -2167,14 +2181,14 @@ void AttackEditor::onTFVEditingSave(std::shared_ptr<TFV> oldTFV, std::shared_ptr
 			}
 			setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
 		},
-			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldTFV, copyOfOld, tfvIdentifier]() {
+			[this, &selectedEMP = this->selectedEMP, &selectedAttack = this->selectedAttack, &selectedEMPA = selectedEMPA, oldTFVFormat, tfvIdentifier]() {
 			if (tfvIdentifier == "homingStrength") {
-				dynamic_cast<MovePlayerHomingEMPA*>(selectedEMPA.get())->setHomingStrength(copyOfOld);
+				dynamic_cast<MovePlayerHomingEMPA*>(selectedEMPA.get())->setHomingStrength(TFVFactory::create(oldTFVFormat));
 			} else {
-				dynamic_cast<MovePlayerHomingEMPA*>(selectedEMPA.get())->setSpeed(copyOfOld);
+				dynamic_cast<MovePlayerHomingEMPA*>(selectedEMPA.get())->setSpeed(TFVFactory::create(oldTFVFormat));
 			}
 			setEMPAWidgetValues(selectedEMPA, selectedEMP, selectedAttack);
-		}));
+		}, oldTFVFormat.capacity() + updatedTFV->format().size()));
 	}
 	//TODO: add EMPAs to this if any other EMPAs also use TFVs
 }
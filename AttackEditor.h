@@ -215,6 +215,12 @@ private:
 	std::shared_ptr<tgui::Label> empiInheritSoundSettingsLabel;
 	std::shared_ptr<tgui::CheckBox> empiInheritSoundSettings;
 
+	/*
+	Returns the coalesce key for UndoableCommands that set a property of the selected EMP or EMPA from a slider,
+	so that dragging the slider creates only one entry in the undo stack.
+	*/
+	std::string getSliderCoalesceKey(std::string propertyName);
+
 	void onEmpiHitboxRadiusChange(float value);
 	void onEmpiDespawnTimeChange(float value);
 	void onEmpiSpawnTypeTimeChange(float value);
@@ -48,7 +48,7 @@ AttackEditorPanel::AttackEditorPanel(EditorWindow& parentWindow, LevelPack& leve
 				this->attack->setName(oldName);
 				name->setText(oldName);
 				onAttackModify.emit(this, this->attack);
-			}));
+			}, text.capacity() + oldName.capacity()));
 		});
 
 		properties->add(id);
@@ -36,6 +36,8 @@ public:
 	inline float getShadowTrailLifespan() const { return shadowTrailLifespan; }
 	inline float getActionsTotalTime() const { return actionsTotalTime; }
 	inline bool usesAttack(int attackID) const { return attackIDCount.count(attackID) > 0 && attackIDCount.at(attackID) > 0; }
+	// Returns a map of the IDs of every EditorAttack this attack pattern uses to the number of times it is used
+	inline const std::map<int, int>& getAttackIDCount() const { return attackIDCount; }
 
 	inline void setShadowTrailInterval(float shadowTrailInterval) { this->shadowTrailInterval = shadowTrailInterval; }
 	inline void setShadowTrailLifespan(float shadowTrailLifespan) { this->shadowTrailLifespan = shadowTrailLifespan; }
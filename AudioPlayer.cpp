@@ -55,17 +55,24 @@ void AudioPlayer::update(float deltaTime) {
 fileName - file name with extension
 volume - in range [0, 100], where 100 is full volume
 */
-void AudioPlayer::playSound(const SoundSettings& soundSettings) {
-	if (soundSettings.isDisabled() || soundSettings.getFileName() == "") return;
-
+bool AudioPlayer::preloadSound(const std::string& fileName) {
 	// Check if the sound's SoundBuffer already exists
-	if (soundBuffers.count(soundSettings.getFileName()) == 0) {
+	if (soundBuffers.count(fileName) == 0) {
 		sf::SoundBuffer buffer;
-		if (!buffer.loadFromFile(soundSettings.getFileName())) {
-			//TODO: handle audio not being able to be loaded
-			return;
+		if (!buffer.loadFromFile(fileName)) {
+			return false;
 		}
-		soundBuffers[soundSettings.getFileName()] = std::move(buffer);
+		soundBuffers[fileName] = std::move(buffer);
+	}
+	return true;
+}
+
+void AudioPlayer::playSound(const SoundSettings& soundSettings) {
+	if (soundSettings.isDisabled() || soundSettings.getFileName() == "") return;
+
+	if (!preloadSound(soundSettings.getFileName())) {
+		//TODO: handle audio not being able to be loaded
+		return;
 	}
 	std::unique_ptr<sf::Sound> sound = std::make_unique<sf::Sound>();
 	sound->setBuffer(soundBuffers[soundSettings.getFileName()]);
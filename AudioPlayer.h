@@ -108,6 +108,11 @@ public:
 
 	void playSound(const SoundSettings& soundSettings);
 	/*
+	Loads a sound file so that it does not have to be loaded the first time it is played.
+	Returns false if the file could not be loaded.
+	*/
+	bool preloadSound(const std::string& fileName);
+	/*
 	Plays music.
 	Returns a pointer to the Music object.
 	*/
@@ -0,0 +1,98 @@
+#include "BloomComparison.h"
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include "Components.h"
+#include "Constants.h"
+#include "Level.h"
+#include "SoftwareRenderSystem.h"
+
+// Number of sprites in the compared frame
+static const int BLOOM_COMPARISON_SPRITES = 300;
+// Diameter of each sprite's texture, in pixels
+static const int BLOOM_COMPARISON_SPRITE_SIZE = 24;
+
+/*
+Returns a white circle that fades out towards its edge.
+*/
+static sf::Texture createSoftCircleTexture(int size) {
+	sf::Image image;
+	image.create(size, size, sf::Color::Transparent);
+	float radius = size / 2.0f;
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			float distance = std::sqrt(std::pow(x + 0.5f - radius, 2) + std::pow(y + 0.5f - radius, 2));
+			if (distance < radius) {
+				image.setPixel(x, y, sf::Color(255, 255, 255, (sf::Uint8)(255 * (1 - distance / radius))));
+			}
+		}
+	}
+	sf::Texture texture;
+	texture.loadFromImage(image);
+	return texture;
+}
+
+std::vector<BloomComparisonResult> compareBloomQualities(int tolerance, int framesCount, unsigned int seed) {
+	sf::RenderWindow window(sf::VideoMode(MAP_WIDTH, MAP_HEIGHT), "Bloom comparison");
+	window.setVisible(false);
+
+	entt::DefaultRegistry registry;
+	RenderSystem renderSystem(registry, window);
+	sf::Vector2u resolution = renderSystem.getResolution();
+	window.setView(sf::View(sf::FloatRect(0, 0, resolution.x, resolution.y)));
+
+	sf::Texture texture = createSoftCircleTexture(BLOOM_COMPARISON_SPRITE_SIZE);
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> randomX(0, MAP_WIDTH);
+	std::uniform_real_distribution<float> randomY(0, MAP_HEIGHT);
+	std::uniform_int_distribution<int> randomChannel(0, 255);
+	for (int i = 0; i < BLOOM_COMPARISON_SPRITES; i++) {
+		std::shared_ptr<sf::Sprite> sprite = std::make_shared<sf::Sprite>(texture);
+		sprite->setOrigin(BLOOM_COMPARISON_SPRITE_SIZE / 2.0f, BLOOM_COMPARISON_SPRITE_SIZE / 2.0f);
+		sprite->setColor(sf::Color(randomChannel(random), randomChannel(random), randomChannel(random)));
+
+		uint32_t entity = registry.create();
+		registry.assign<PositionComponent>(entity, randomX(random), randomY(random));
+		registry.assign<SpriteComponent>(entity, LOCK_ROTATION, sprite, ENEMY_BULLET_LAYER, (float)i);
+	}
+
+	std::vector<BloomComparisonResult> results;
+	sf::Image fullResolutionImage;
+	std::vector<BLOOM_QUALITY> qualities = { BLOOM_FULL_RESOLUTION, BLOOM_HALF_RESOLUTION, BLOOM_QUARTER_RESOLUTION, BLOOM_EIGHTH_RESOLUTION };
+	for (BLOOM_QUALITY quality : qualities) {
+		// Same settings as the default level's bullets
+		std::shared_ptr<Level> level = std::make_shared<Level>();
+		BloomSettings bloomSettings(1.2f, 0.05f);
+		bloomSettings.setQuality(quality);
+		level->getBloomLayerSettings()[ENEMY_BULLET_LAYER] = bloomSettings;
+		renderSystem.loadLevelRenderSettings(level);
+
+		BloomComparisonResult result;
+		result.quality = quality;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < framesCount; i++) {
+			window.clear();
+			renderSystem.update(0);
+			window.display();
+		}
+		// Reading the frame back waits for the GPU to finish drawing it
+		window.clear();
+		renderSystem.update(0);
+		sf::Texture frame;
+		frame.create(window.getSize().x, window.getSize().y);
+		frame.update(window);
+		sf::Image image = frame.copyToImage();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		result.frameTime = (float)(elapsed.count() / (framesCount + 1));
+
+		if (quality == BLOOM_FULL_RESOLUTION) {
+			fullResolutionImage = image;
+		}
+		result.differentPixels = SoftwareRenderSystem::countDifferentPixels(image, fullResolutionImage, tolerance);
+		result.totalPixels = image.getSize().x * image.getSize().y;
+		results.push_back(result);
+	}
+	return results;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+#include "RenderSystem.h"
+
+/*
+How a bloom quality compares to full resolution bloom on the same frame.
+*/
+struct BloomComparisonResult {
+	BLOOM_QUALITY quality;
+	// Number of pixels that differ from the full resolution frame by more than the tolerance in any channel
+	int differentPixels = 0;
+	int totalPixels = 0;
+	// Average time to draw and display a frame, in milliseconds
+	float frameTime = 0;
+};
+
+/*
+Draws the same frame with a RenderSystem at every bloom quality and compares each one to BLOOM_FULL_RESOLUTION, pixel by pixel.
+The frame is made of soft circles with random positions and colors from a fixed seed, all in a layer with bloom,
+so the comparison only depends on the bloom quality and the GPU.
+
+Opens a hidden window, since bloom is drawn with shaders.
+The first result is always BLOOM_FULL_RESOLUTION itself.
+
+tolerance - how much a channel can differ before the pixel counts as different
+framesCount - frames drawn at each quality to time it
+*/
+std::vector<BloomComparisonResult> compareBloomQualities(int tolerance, int framesCount, unsigned int seed = 0);
@@ -1,9 +1,20 @@
 #include "CollectibleSystem.h"
 #include <algorithm>
 
-CollectibleSystem::CollectibleSystem(EntityCreationQueue & queue, entt::DefaultRegistry & registry, const LevelPack& levelPack, float mapWidth, float mapHeight) : queue(queue), registry(registry) {
-	itemHitboxTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, levelPack.searchLargestItemCollectionHitbox() * 2.0f);
-	activationTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, levelPack.searchLargestItemActivationHitbox() * 2.0f);
+CollectibleSystem::CollectibleSystem(EntityCreationQueue & queue, entt::DefaultRegistry & registry, float mapWidth, float mapHeight) : queue(queue), registry(registry), mapWidth(mapWidth), mapHeight(mapHeight) {
+	// Until a level is loaded, there is no way of knowing the item sizes
+	float defaultCellSize = std::max(mapWidth, mapHeight) / 10.0f;
+	itemHitboxTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, defaultCellSize);
+	activationTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, defaultCellSize);
+}
+
+void CollectibleSystem::loadLevelProfile(const LevelProfile& profile) {
+	float defaultCellSize = std::max(mapWidth, mapHeight) / 10.0f;
+	// Items with a radius of 0 would make cells of size 0
+	float itemHitboxCellSize = profile.largestItemCollectionHitbox > 0 ? profile.largestItemCollectionHitbox * 2.0f : defaultCellSize;
+	float activationCellSize = profile.largestItemActivationHitbox > 0 ? profile.largestItemActivationHitbox * 2.0f : defaultCellSize;
+	itemHitboxTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, itemHitboxCellSize);
+	activationTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, activationCellSize);
 }
 
 void CollectibleSystem::update(float deltaTime) {
@@ -10,12 +10,19 @@ Manages collectibles
 */
 class CollectibleSystem {
 public:
-	CollectibleSystem(EntityCreationQueue& queue, entt::DefaultRegistry& registry, const LevelPack& levelPack, float mapWidth, float mapHeight);
+	CollectibleSystem(EntityCreationQueue& queue, entt::DefaultRegistry& registry, float mapWidth, float mapHeight);
 	void update(float deltaTime);
+	/*
+	Resizes the spatial hash tables to suit a level.
+	Should be called whenever a level is loaded.
+	*/
+	void loadLevelProfile(const LevelProfile& profile);
 
 private:
 	EntityCreationQueue& queue;
 	entt::DefaultRegistry& registry;
+	float mapWidth;
+	float mapHeight;
 
 	// Spatial hash table with cell size equal to largest item hitbox; contains all entities with CollectibleComponent inserted normally
 	SpatialHashTable<uint32_t> itemHitboxTable;
@@ -7,14 +7,51 @@
 #include "LevelPack.h"
 #include <algorithm>
 
-CollisionSystem::CollisionSystem(LevelPack& levelPack, EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry & registry, float mapWidth, float mapHeight) : levelPack(levelPack), queue(queue), spriteLoader(spriteLoader), registry(registry) {
-	defaultTableObjectMaxSize = 2.0f * std::max(mapWidth, mapHeight) / 10.0;
-	defaultTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, defaultTableObjectMaxSize/2.0f);
-	largeObjectsTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, levelPack.searchLargestBulletHitbox() * 2.0f);
+CollisionSystem::CollisionSystem(LevelPack& levelPack, EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry & registry, float mapWidth, float mapHeight) : levelPack(levelPack), queue(queue), spriteLoader(spriteLoader), registry(registry), 
+mapWidth(mapWidth), mapHeight(mapHeight) {
+	// Until a level is loaded, there is no way of knowing the largest hitbox, so have levels up to the size of the map
+	float largestRadius = std::max(mapWidth, mapHeight) / 2.0f;
+	enemyBulletTable = HierarchicalSpatialHashTable<uint32_t>(mapWidth, mapHeight, SMALLEST_COLLISION_CELL_SIZE, largestRadius);
+	playerBulletTable = HierarchicalSpatialHashTable<uint32_t>(mapWidth, mapHeight, SMALLEST_COLLISION_CELL_SIZE, largestRadius);
+}
+
+void CollisionSystem::loadLevelProfile(const LevelProfile& profile) {
+	// Only have as many levels as the largest bullet needs
+	enemyBulletTable = HierarchicalSpatialHashTable<uint32_t>(mapWidth, mapHeight, SMALLEST_COLLISION_CELL_SIZE, profile.largestBulletHitbox);
+	playerBulletTable = HierarchicalSpatialHashTable<uint32_t>(mapWidth, mapHeight, SMALLEST_COLLISION_CELL_SIZE, profile.largestBulletHitbox);
+}
+
+bool CollisionSystem::insertBullet(HierarchicalSpatialHashTable<uint32_t>& table, uint32_t bullet, const PositionComponent& bulletPosition, const HitboxComponent& bulletHitbox) {
+	if (!isFastBullet(bulletPosition, bulletHitbox)) {
+		return table.insert(bullet, bulletHitbox, bulletPosition);
+	}
+	// Insert a circle around the midpoint of the movement that covers the whole capsule
+	float dx = bulletPosition.getX() - bulletPosition.getPreviousX();
+	float dy = bulletPosition.getY() - bulletPosition.getPreviousY();
+	PositionComponent midpoint(bulletPosition.getX() - dx / 2.0f, bulletPosition.getY() - dy / 2.0f);
+	return table.insert(bullet, bulletHitbox.getX(), bulletHitbox.getY(), bulletHitbox.getRadius() + sqrt(dx * dx + dy * dy) / 2.0f, midpoint);
+}
+
+bool CollisionSystem::sweptCollides(const PositionComponent& entityPosition, const HitboxComponent& entityHitbox, const PositionComponent& bulletPosition, const HitboxComponent& bulletHitbox) {
+	if (!isFastBullet(bulletPosition, bulletHitbox)) {
+		return collides(entityPosition, entityHitbox, bulletPosition, bulletHitbox);
+	}
+	float entityX = entityPosition.getX() + entityHitbox.getX();
+	float entityY = entityPosition.getY() + entityHitbox.getY();
+	// The bullet's hitbox offset is assumed to not have changed over the movement
+	float startX = bulletPosition.getPreviousX() + bulletHitbox.getX();
+	float startY = bulletPosition.getPreviousY() + bulletHitbox.getY();
+	float dx = bulletPosition.getX() - bulletPosition.getPreviousX();
+	float dy = bulletPosition.getY() - bulletPosition.getPreviousY();
+
+	// Find the point along the movement closest to the entity's hitbox
+	// dx and dy can't both be 0 since the bullet is fast
+	float t = ((entityX - startX) * dx + (entityY - startY) * dy) / (dx * dx + dy * dy);
+	t = std::max(0.0f, std::min(1.0f, t));
+	return distance(startX + t * dx, startY + t * dy, entityX, entityY) <= (entityHitbox.getRadius() + bulletHitbox.getRadius());
 }
 
 void CollisionSystem::update(float deltaTime) {
-	auto playerView = registry.view<PlayerTag, PositionComponent, HitboxComponent>(entt::persistent_t{});
 	auto enemyView = registry.view<EnemyComponent, PositionComponent, HitboxComponent>(entt::persistent_t{});
 	auto playerBulletView = registry.view<PlayerBulletComponent, PositionComponent, HitboxComponent>(entt::persistent_t{});
 	auto enemyBulletView = registry.view<EnemyBulletComponent, PositionComponent, HitboxComponent>(entt::persistent_t{});
@@ -27,45 +64,26 @@ void CollisionSystem::update(float deltaTime) {
 		// Since HitboxComponent's update is only for updating hitbox disable time and only the player's hitbox can be disabled,
 		// only update the player's hitbox
 		playerHitbox.update(deltaTime);
-
-		// largeObjectsTable always contains players and enemies
-		// Insert player
-		if (playerHitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(player, playerHitbox, playerPosition);
-		}
-		largeObjectsTable.insert(player, playerHitbox, playerPosition);
 	}
 
-	// Reinsert all bullets, players, and enemies into tables
-	defaultTable.clear();
-	largeObjectsTable.clear();
+	// Reinsert all bullets into tables
+	// Players and enemies are never looked up in the tables, so they aren't inserted
+	enemyBulletTable.clear();
+	playerBulletTable.clear();
+	culledCount = 0;
 	playerBulletView.each([&](auto entity, auto& playerBullet, auto& position, auto& hitbox) {
 		playerBullet.update(deltaTime);
 
-		// Check hitbox size for insertion into correct table
-		if (hitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(entity, hitbox, position);
-		} else {
-			largeObjectsTable.insert(entity, hitbox, position);
+		if (!insertBullet(playerBulletTable, entity, position, hitbox)) {
+			culledCount++;
 		}
 	});
 	enemyBulletView.each([&](auto entity, auto& enemyBullet, auto& position, auto& hitbox) {
 		enemyBullet.update(deltaTime);
 
-		// Check hitbox size for insertion into correct table
-		if (hitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(entity, hitbox, position);
-		} else {
-			largeObjectsTable.insert(entity, hitbox, position);
-		}
-	});
-
-	// Insert enemies
-	enemyView.each([&](auto entity, auto& enemy, auto& position, auto& hitbox) {
-		if (hitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(entity, hitbox, position);
+		if (!insertBullet(enemyBulletTable, entity, position, hitbox)) {
+			culledCount++;
 		}
-		largeObjectsTable.insert(entity, hitbox, position);
 	});
 
 	// Collision detection, looping through only players and enemies
@@ -77,11 +95,10 @@ void CollisionSystem::update(float deltaTime) {
 		// Check for player
 		
 		if (!playerHitbox.isDisabled()) {
-			auto all = defaultTable.getNearbyObjects(playerHitbox, playerPosition);
-			auto large = largeObjectsTable.getNearbyObjects(playerHitbox, playerPosition);
-			all.insert(all.end(), large.begin(), large.end());
-			for (auto bullet : all) {
-				// Make sure it's an enemy bullet
+			nearbyBullets.clear();
+			enemyBulletTable.getNearbyObjects(playerHitbox, playerPosition, nearbyBullets);
+			for (auto bullet : nearbyBullets) {
+				// A bullet can be in multiple cells, so it may have already stopped being an enemy bullet earlier in this loop
 				if (!registry.has<EnemyBulletComponent>(bullet)) {
 					continue;
 				}
@@ -95,7 +112,7 @@ void CollisionSystem::update(float deltaTime) {
 				auto& bulletPosition = enemyBulletView.get<PositionComponent>(bullet);
 				auto& bulletHitbox = enemyBulletView.get<HitboxComponent>(bullet);
 				// Note: No DeathComponent::isMarkedForDeath() check here because player does not despawn on death
-				if (registry.get<EnemyBulletComponent>(bullet).isValidCollision(player) && !bulletHitbox.isDisabled() && collides(playerPosition, playerHitbox, bulletPosition, bulletHitbox)) {
+				if (registry.get<EnemyBulletComponent>(bullet).isValidCollision(player) && !bulletHitbox.isDisabled() && sweptCollides(playerPosition, playerHitbox, bulletPosition, bulletHitbox)) {
 					// Player takes damage
 					// Disable hitbox for invulnerability time
 					float invulnTime = registry.get<PlayerTag>().getInvulnerabilityTime();
@@ -149,20 +166,25 @@ void CollisionSystem::update(float deltaTime) {
 	}
 
 	enemyView.each([&](auto entity, auto& enemy, auto& position, auto& hitbox) {
-		if (!hitbox.isDisabled()) {
-			auto all = defaultTable.getNearbyObjects(hitbox, position);
-			auto large = largeObjectsTable.getNearbyObjects(hitbox, position);
-			all.insert(all.end(), large.begin(), large.end());
-			for (auto bullet : all) {
-				// Make sure it's a player bullet
+		auto& despawn = registry.get<DespawnComponent>(entity);
+		if (!hitbox.isDisabled() && !despawn.isMarkedForDespawn()) {
+			nearbyBullets.clear();
+			playerBulletTable.getNearbyObjects(hitbox, position, nearbyBullets);
+			for (auto bullet : nearbyBullets) {
+				// A bullet can be in multiple cells, so it may have already stopped being a player bullet earlier in this loop
 				if (!registry.has<PlayerBulletComponent>(bullet)) {
 					continue;
 				}
+				// The enemy died from an earlier bullet in this loop
+				if (despawn.isMarkedForDespawn()) {
+					break;
+				}
 
 				auto& bulletPosition = playerBulletView.get<PositionComponent>(bullet);
 				auto& bulletHitbox = playerBulletView.get<HitboxComponent>(bullet);
-				if (!registry.get<DespawnComponent>(entity).isMarkedForDespawn() && registry.get<PlayerBulletComponent>(bullet).isValidCollision(entity) && !bulletHitbox.isDisabled() && collides(position, hitbox, bulletPosition, bulletHitbox)) {
+				if (registry.get<PlayerBulletComponent>(bullet).isValidCollision(entity) && !bulletHitbox.isDisabled() && sweptCollides(position, hitbox, bulletPosition, bulletHitbox)) {
 					// Enemy takes damage
+					enemy.onHealthChange();
 					if (registry.has<HealthComponent>(entity) && registry.get<HealthComponent>(entity).takeDamage(registry.get<PlayerBulletComponent>(bullet).getDamage())) {
 						// Enemy is dead
 
@@ -183,7 +205,7 @@ void CollisionSystem::update(float deltaTime) {
 						}
 
 						// Delete enemy
-						registry.get<DespawnComponent>(entity).setMaxTime(0);
+						despawn.setMaxTime(0);
 					} else {
 						registry.get<PlayerBulletComponent>(bullet).onCollision(entity);
 
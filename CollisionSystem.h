@@ -1,10 +1,11 @@
 #pragma once
 #include <entt/entt.hpp>
-#include "SpatialHashTable.h"
+#include "HierarchicalSpatialHashTable.h"
 #include "SpriteLoader.h"
 #include "EntityCreationQueue.h"
 
 class HitboxComponent;
+struct LevelProfile;
 
 enum BULLET_ON_COLLISION_ACTION {
 	DESTROY_THIS_BULLET_AND_ATTACHED_CHILDREN, // All attached EMPs and itself are destroyed
@@ -16,18 +17,37 @@ class CollisionSystem {
 public:
 	CollisionSystem(LevelPack& levelPack, EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry& registry, float mapWidth, float mapHeight);
 	void update(float deltaTime);
+	/*
+	Resizes the spatial hash tables to suit a level.
+	Should be called whenever a level is loaded.
+	*/
+	void loadLevelProfile(const LevelProfile& profile);
+
+	/*
+	Returns the number of bullets that were not inserted into any spatial hash table
+	in the last update because they were completely outside the map.
+	*/
+	inline int getCulledCount() const { return culledCount; }
+
+	/*
+	The tables are exposed so that their per-level occupancy can be inspected.
+	*/
+	inline const HierarchicalSpatialHashTable<uint32_t>& getEnemyBulletTable() const { return enemyBulletTable; }
+	inline const HierarchicalSpatialHashTable<uint32_t>& getPlayerBulletTable() const { return playerBulletTable; }
 
 private:
 	LevelPack& levelPack;
 	EntityCreationQueue& queue;
 	SpriteLoader& spriteLoader;
 	entt::DefaultRegistry& registry;
-	// Spatial hash table with cell size equal to max(mapWidth, mapHeight)/10
-	SpatialHashTable<uint32_t> defaultTable;
-	// Spatial hash table with cell size equal to 2 * radius of largest hitbox; always contains all enemies and players
-	SpatialHashTable<uint32_t> largeObjectsTable;
-	// Cutoff size for insertion into default table; 2 * max(mapWidth, mapHeight)/10 since hitbox size is 2*radius
-	float defaultTableObjectMaxSize;
+	// Bullets are split into tables by kind, since players only collide with enemy bullets and enemies only with player bullets
+	HierarchicalSpatialHashTable<uint32_t> enemyBulletTable;
+	HierarchicalSpatialHashTable<uint32_t> playerBulletTable;
+	float mapWidth;
+	float mapHeight;
+	int culledCount = 0;
+	// Reused by every lookup in the tables to avoid reallocating
+	std::vector<uint32_t> nearbyBullets;
 
 	inline float distance(float x1, float y1, float x2, float y2) {
 		return sqrt((x1 - x2)*(x1 - x2) + (y1 - y2)*(y1 - y2));
@@ -36,4 +56,28 @@ private:
 	inline bool collides(const PositionComponent& p1, const HitboxComponent& h1, const PositionComponent& p2, const HitboxComponent& h2) {
 		return distance(p1.getX() + h1.getX(), p1.getY() + h1.getY(), p2.getX() + h2.getX(), p2.getY() + h2.getY()) <= (h1.getRadius() + h2.getRadius());
 	}
+
+	/*
+	Returns whether a bullet moved farther than its hitbox radius in the last update,
+	in which case it could have passed completely through an entity and must be checked along its whole movement.
+	*/
+	inline bool isFastBullet(const PositionComponent& bulletPosition, const HitboxComponent& bulletHitbox) {
+		float dx = bulletPosition.getX() - bulletPosition.getPreviousX();
+		float dy = bulletPosition.getY() - bulletPosition.getPreviousY();
+		return dx * dx + dy * dy > bulletHitbox.getRadius() * bulletHitbox.getRadius();
+	}
+
+	/*
+	Inserts a bullet into a table.
+	Fast bullets are inserted with a hitbox covering their whole movement in the last update.
+	Returns false if the bullet was not inserted because it is completely outside the map.
+	*/
+	bool insertBullet(HierarchicalSpatialHashTable<uint32_t>& table, uint32_t bullet, const PositionComponent& bulletPosition, const HitboxComponent& bulletHitbox);
+
+	/*
+	Returns whether a bullet collides with an entity.
+	Fast bullets are checked along their whole movement in the last update (a capsule) rather than only at their current position.
+	The entity is treated as if it did not move.
+	*/
+	bool sweptCollides(const PositionComponent& entityPosition, const HitboxComponent& entityHitbox, const PositionComponent& bulletPosition, const HitboxComponent& bulletHitbox);
 };
\ No newline at end of file
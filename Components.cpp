@@ -22,7 +22,10 @@ const float sigma = 0.00001f;
 
 MovementPathComponent::MovementPathComponent(EntityCreationQueue & queue, uint32_t self, entt::DefaultRegistry & registry, uint32_t entity, MPSpawnInformation spawnInfo, std::vector<std::shared_ptr<EMPAction>> actions, float initialTime) : actions(actions), time(initialTime) {
 	initialSpawn(registry, entity, spawnInfo, actions);
-	update(queue, registry, self, registry.get<PositionComponent>(self), 0);
+	auto& position = registry.get<PositionComponent>(self);
+	update(queue, registry, self, position, 0);
+	// Being spawned is not movement
+	position.savePreviousPosition();
 }
 
 void MovementPathComponent::update(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, PositionComponent& entityPosition, float deltaTime) {
@@ -119,6 +122,47 @@ void MovementPathComponent::setPath(EntityCreationQueue& queue, entt::DefaultReg
 	update(queue, registry, entity, entityPosition, 0);
 }
 
+void MovementPathComponent::deepCopyPaths() {
+	path = path->clone();
+	for (int i = 0; i < previousPaths.size(); i++) {
+		previousPaths[i] = previousPaths[i]->clone();
+	}
+}
+
+bool MovementPathComponent::staysOutside(entt::DefaultRegistry& registry, const PositionComponent& entityPosition, const sf::FloatRect& bounds) {
+	// Any remaining action can change the path to anything
+	if (currentActionsIndex < actions.size()) {
+		return false;
+	}
+
+	sf::Vector2f relativeTo(0, 0);
+	if (useReferenceEntity) {
+		// A reference entity without a MovementPathComponent, like the player, can be moved by something else at any time
+		if (!registry.valid(referenceEntity) || !registry.has<MovementPathComponent>(referenceEntity) || !registry.get<MovementPathComponent>(referenceEntity).isStationaryForever(registry)) {
+			return false;
+		}
+		auto& pos = registry.get<PositionComponent>(referenceEntity);
+		relativeTo = sf::Vector2f(pos.getX(), pos.getY());
+	}
+
+	if (time >= path->getLifespan()) {
+		// The entity stays at the end of its path forever
+		return !bounds.contains(entityPosition.getX(), entityPosition.getY());
+	}
+	return path->staysOutside(relativeTo, time, bounds);
+}
+
+bool MovementPathComponent::isStationaryForever(entt::DefaultRegistry& registry) {
+	if (currentActionsIndex < actions.size() || time < path->getLifespan()) {
+		return false;
+	}
+	if (useReferenceEntity) {
+		// A reference entity without a MovementPathComponent, like the player, can be moved by something else at any time
+		return registry.valid(referenceEntity) && registry.has<MovementPathComponent>(referenceEntity) && registry.get<MovementPathComponent>(referenceEntity).isStationaryForever(registry);
+	}
+	return true;
+}
+
 void MovementPathComponent::initialSpawn(entt::DefaultRegistry& registry, uint32_t entity, std::shared_ptr<EMPSpawnType> spawnType, std::vector<std::shared_ptr<EMPAction>>& actions) {
 	auto spawnInfo = spawnType->getSpawnInfo(registry, entity, time);
 	useReferenceEntity = spawnInfo.useReferenceEntity;
@@ -141,9 +185,15 @@ void EnemyComponent::update(EntityCreationQueue& queue, SpriteLoader& spriteLoad
 	timeSincePhase += deltaTime;
 	timeSinceAttackPattern += deltaTime;
 
-	checkAttacks(queue, spriteLoader, levelPack, registry, entity);
-	checkAttackPatterns(queue, spriteLoader, levelPack, registry, entity);
-	checkPhases(queue, spriteLoader, levelPack, registry, entity);
+	if (timeSinceAttackPattern >= nextAttackTime) {
+		checkAttacks(queue, spriteLoader, levelPack, registry, entity);
+	}
+	if (timeSincePhase >= nextAttackPatternTime) {
+		checkAttackPatterns(queue, spriteLoader, levelPack, registry, entity);
+	}
+	if (nextPhaseCheckOutdated || timeSincePhase >= nextPhaseTime) {
+		checkPhases(queue, spriteLoader, levelPack, registry, entity);
+	}
 }
 
 std::shared_ptr<DeathAction> EnemyComponent::getCurrentDeathAnimationAction() {
@@ -162,10 +212,14 @@ std::shared_ptr<entt::SigH<void(uint32_t, std::shared_ptr<EditorEnemyPhase>, std
 void EnemyComponent::checkPhases(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity) {	
 	// Check if entity can continue to next phase
 	// While loop so that enemy can skip phases
+	nextPhaseCheckOutdated = false;
 	while (currentPhaseIndex + 1 < enemyData->getPhasesCount()) {
-		auto nextPhaseData = enemyData->getPhaseData(currentPhaseIndex + 1);
+		auto& nextPhaseStartCondition = enemyData->getPhaseStartCondition(currentPhaseIndex + 1);
+		float satisfiedTime = nextPhaseStartCondition->getSatisfiedTime();
 		// Check if condition for next phase is satisfied
-		if (std::get<0>(nextPhaseData)->satisfied(registry, entity)) {
+		if (satisfiedTime >= 0 ? timeSincePhase >= satisfiedTime : nextPhaseStartCondition->satisfied(registry, entity)) {
+			auto nextPhaseData = enemyData->getPhaseData(currentPhaseIndex + 1);
+
 			// Current phase ends, so call its ending EnemyPhaseAction
 			if (currentPhase && currentPhase->getPhaseEndAction()) {
 				currentPhase->getPhaseEndAction()->execute(registry, entity);
@@ -180,6 +234,7 @@ void EnemyComponent::checkPhases(EntityCreationQueue& queue, SpriteLoader& sprit
 
 			currentPhase = levelPack.getEnemyPhase(std::get<1>(nextPhaseData));
 			currentAttackPattern = nullptr;
+			nextAttackTime = NOTHING_SCHEDULED;
 
 			// Do not loop through attack patterns while in this current phase if no attack pattern in this phase takes longer than 0 secoonds
 			// to execute, to prevent an infinite loop in checkAttackPatterns()
@@ -224,9 +279,17 @@ void EnemyComponent::checkPhases(EntityCreationQueue& queue, SpriteLoader& sprit
 
 			checkAttackPatterns(queue, spriteLoader, levelPack, registry, entity);
 		} else {
-			break;
+			if (satisfiedTime >= 0) {
+				nextPhaseTime = satisfiedTime;
+			} else {
+				// Wait for onHealthChange() or onEnemyCountChange()
+				nextPhaseTime = NOTHING_SCHEDULED;
+			}
+			return;
 		}
 	}
+	// No more phases
+	nextPhaseTime = NOTHING_SCHEDULED;
 }
 
 void EnemyComponent::checkAttackPatterns(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity) {
@@ -251,9 +314,11 @@ void EnemyComponent::checkAttackPatterns(EntityCreationQueue& queue, SpriteLoade
 
 			checkAttacks(queue, spriteLoader, levelPack, registry, entity);
 		} else {
-			break;
+			nextAttackPatternTime = nextAttackPattern.first;
+			return;
 		}
 	}
+	nextAttackPatternTime = NOTHING_SCHEDULED;
 }
 
 void EnemyComponent::checkAttacks(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity) {
@@ -264,28 +329,52 @@ void EnemyComponent::checkAttacks(EntityCreationQueue& queue, SpriteLoader& spri
 			currentAttackIndex++;
 			levelPack.getAttack(nextAttack.second)->executeAsEnemy(queue, spriteLoader, registry, entity, timeSinceAttackPattern - nextAttack.first, currentAttackPattern->getID(), enemyID, currentPhase->getID());
 		} else {
-			break;
+			nextAttackTime = nextAttack.first;
+			return;
 		}
 	}
+	// No more attacks in the current attack pattern
+	nextAttackTime = NOTHING_SCHEDULED;
 }
 
-LevelManagerTag::LevelManagerTag(LevelPack* levelPack, std::shared_ptr<Level> level) : levelPack(levelPack), level(level) {
+LevelManagerTag::LevelManagerTag(LevelPack* levelPack, std::shared_ptr<Level> level, uint64_t randomSeed) : levelPack(levelPack), level(level), randomSeed(randomSeed) {
 }
 
 void LevelManagerTag::update(EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry& registry, float deltaTime) {
 	timeSinceStartOfLevel += deltaTime;
 	timeSinceLastEnemySpawn += deltaTime;
 
+	// The next start condition can only become satisfied by the passage of time or by an enemy spawn or despawn,
+	// so it is only evaluated when one of those changes the time at which it will be satisfied
 	while (currentLevelEventsIndex + 1 < level->getEventsCount()) {
-		if (level->conditionSatisfied(currentLevelEventsIndex + 1, registry)) {
+		if (nextLevelEventTimeOutdated) {
+			nextLevelEventTime = level->getConditionSatisfiedTime(currentLevelEventsIndex + 1, timeSinceStartOfLevel, timeSinceLastEnemySpawn, enemiesAlive);
+			nextLevelEventTimeOutdated = false;
+		}
+		if (nextLevelEventTime >= 0 && timeSinceStartOfLevel >= nextLevelEventTime) {
 			level->executeEvent(currentLevelEventsIndex + 1, spriteLoader, *levelPack, registry, queue);
 			currentLevelEventsIndex++;
+			nextLevelEventTimeOutdated = true;
 		} else {
 			break;
 		}
 	}
 }
 
+SpriteComponent::SpriteComponent(const SpriteComponent& copy) : renderLayer(copy.renderLayer), subLayer(copy.subLayer), rotationType(copy.rotationType), 
+	lastFacedRight(copy.lastFacedRight), rotationAngle(copy.rotationAngle), rotationAngleFromMovement(copy.rotationAngleFromMovement), lastMovementX(copy.lastMovementX), 
+	lastMovementY(copy.lastMovementY), originalSprite(copy.originalSprite) {
+	if (copy.sprite) {
+		sprite = std::make_shared<sf::Sprite>(*copy.sprite);
+	}
+	if (copy.effectAnimation) {
+		effectAnimation = copy.effectAnimation->clone(sprite);
+	}
+	if (copy.animation) {
+		animation = std::make_unique<Animation>(*copy.animation);
+	}
+}
+
 void SpriteComponent::update(float deltaTime) {
 	if (animation != nullptr) {
 		auto newSprite = animation->update(deltaTime);
@@ -299,12 +388,18 @@ void SpriteComponent::update(float deltaTime) {
 	if (sprite) {
 		if (effectAnimation != nullptr) {
 			effectAnimation->update(deltaTime);
+			transformChanged = true;
 		}
 
 		// Rotate sprite
 		if (rotationType == ROTATE_WITH_MOVEMENT) {
-			// Negative because SFML uses clockwise rotation
-			sprite->setRotation(-rotationAngle * 180.0 / PI);
+			if (!rotationApplied || rotationAngle != appliedRotationAngle) {
+				// Negative because SFML uses clockwise rotation
+				sprite->setRotation(-rotationAngle * 180.0 / PI);
+				appliedRotationAngle = rotationAngle;
+				rotationApplied = true;
+				transformChanged = true;
+			}
 		} else if (rotationType == LOCK_ROTATION) {
 			// Do nothing
 		} else if (rotationType == LOCK_ROTATION_AND_FACE_HORIZONTAL_MOVEMENT) {
@@ -314,14 +409,17 @@ void SpriteComponent::update(float deltaTime) {
 				lastFacedRight = false;
 				if (curScale.x > 0) {
 					sprite->setScale(-1.0f * curScale.x, curScale.y);
+					transformChanged = true;
 				}
 			} else if (rotationAngle > -PI / 2.0f + sigma && rotationAngle < PI / 2.0f - sigma) {
 				lastFacedRight = true;
 				if (curScale.x < 0) {
 					sprite->setScale(-1.0f * curScale.x, curScale.y);
+					transformChanged = true;
 				}
 			} else if ((lastFacedRight && curScale.x < 0) || (!lastFacedRight && curScale.x > 0)) {
 				sprite->setScale(-1.0f * curScale.x, curScale.y);
+				transformChanged = true;
 			}
 			// Do nothing (maintain last values) if angle is a perfect 90 or -90 degree angle
 		}
@@ -636,13 +734,10 @@ std::shared_ptr<Item> CollectibleComponent::getItem() {
 }
 
 void HitboxComponent::rotate(float angle) {
-	if (unrotatedX == unrotatedY == 0) return;
+	if (unrotatedX == 0 && unrotatedY == 0) return;
 
 	if (rotationType == ROTATE_WITH_MOVEMENT) {
-		float sin = std::sin(angle);
-		float cos = std::cos(angle);
-		x = unrotatedX * cos - unrotatedY * sin;
-		y = unrotatedX * sin + unrotatedY * cos;
+		rotate(std::sin(angle), std::cos(angle));
 	} else if (rotationType == LOCK_ROTATION) {
 		// Do nothing
 	} else if (rotationType == LOCK_ROTATION_AND_FACE_HORIZONTAL_MOVEMENT) {
@@ -656,6 +751,13 @@ void HitboxComponent::rotate(float angle) {
 	}
 }
 
+void HitboxComponent::rotate(float sinAngle, float cosAngle) {
+	if (unrotatedX == 0 && unrotatedY == 0) return;
+
+	x = unrotatedX * cosAngle - unrotatedY * sinAngle;
+	y = unrotatedX * sinAngle + unrotatedY * cosAngle;
+}
+
 void EnemyBulletComponent::update(float deltaTime) {
 	for (auto& it = ignoredEntities.begin(); it != ignoredEntities.end(); it++) {
 		it->second -= deltaTime;
@@ -728,11 +830,18 @@ std::shared_ptr<entt::SigH<void(uint32_t)>> LevelManagerTag::getEnemySpawnSignal
 
 void LevelManagerTag::onEnemySpawn(uint32_t enemy) {
 	timeSinceLastEnemySpawn = 0;
+	enemiesAlive++;
+	nextLevelEventTimeOutdated = true;
 	if (enemySpawnSignal) {
 		enemySpawnSignal->publish(enemy);
 	}
 }
 
+void LevelManagerTag::onEnemyDespawn(uint32_t enemy) {
+	enemiesAlive--;
+	nextLevelEventTimeOutdated = true;
+}
+
 void LevelManagerTag::onPointsChange() {
 	if (pointsChangeSignal) {
 		pointsChangeSignal->publish(points);
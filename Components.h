@@ -19,6 +19,7 @@
 #include "Animatable.h"
 #include "EnemySpawn.h"
 #include "AudioPlayer.h"
+#include "RandomStream.h"
 
 class MovablePoint;
 class AggregatorMP;
@@ -39,17 +40,29 @@ struct MPSpawnInformation;
 
 class PositionComponent {
 public:
-	PositionComponent(float x = 0, float y = 0) : x(x), y(y) {}
+	PositionComponent(float x = 0, float y = 0) : x(x), y(y), previousX(x), previousY(y) {}
 
 	inline float getX() const { return x; }
 	inline float getY() const { return y; }
+	/*
+	Returns the position as of the last savePreviousPosition() call.
+	MovementSystem calls it right before moving an entity, so this is where the entity was before its last movement.
+	*/
+	inline float getPreviousX() const { return previousX; }
+	inline float getPreviousY() const { return previousY; }
 	inline void setX(float x) { this->x = x; }
 	inline void setY(float y) { this->y = y; }
 	void setPosition(sf::Vector2f position) { x = position.x; y = position.y; }
+	inline void savePreviousPosition() {
+		previousX = x;
+		previousY = y;
+	}
 
 private:
 	float x;
 	float y;
+	float previousX;
+	float previousY;
 };
 
 class MovementPathComponent {
@@ -59,7 +72,10 @@ public:
 	*/
 	inline MovementPathComponent(EntityCreationQueue& queue, uint32_t self, entt::DefaultRegistry& registry, uint32_t entity, std::shared_ptr<EMPSpawnType> spawnType, std::vector<std::shared_ptr<EMPAction>> actions, float initialTime) : actions(actions), time(initialTime) {
 		initialSpawn(registry, entity, spawnType, actions);
-		update(queue, registry, self, registry.get<PositionComponent>(self), 0);
+		auto& position = registry.get<PositionComponent>(self);
+		update(queue, registry, self, position, 0);
+		// Being spawned is not movement
+		position.savePreviousPosition();
 	}
 
 	/*
@@ -97,6 +113,25 @@ public:
 	*/
 	void setPath(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, PositionComponent& entityPosition, std::shared_ptr<MovablePoint> newPath, float timeLag);
 
+	/*
+	Replaces path and every previous path with deep copies so that this component no longer
+	shares any MovablePoint with the component it was copied from.
+	*/
+	void deepCopyPaths();
+
+	/*
+	Returns true if it can be proven that this entity will never be inside bounds again.
+	False only means that it could not be proven.
+
+	entityPosition - this entity's position
+	bounds - left and top are the minimum x and y
+	*/
+	bool staysOutside(entt::DefaultRegistry& registry, const PositionComponent& entityPosition, const sf::FloatRect& bounds);
+	/*
+	Returns true if the entity with this component will never move again.
+	*/
+	bool isStationaryForever(entt::DefaultRegistry& registry);
+
 private:
 	bool useReferenceEntity;
 	uint32_t referenceEntity;
@@ -194,6 +229,23 @@ public:
 	*/
 	void rotate(float angle);
 	/*
+	Rotates the hitbox to face a direction of movement without needing the angle.
+	Does nothing if the entity did not move.
+
+	dx, dy - change in position since the last update
+	*/
+	inline void rotateToMovement(float dx, float dy) {
+		if (rotationType == LOCK_ROTATION || (dx == 0 && dy == 0)) {
+			return;
+		}
+		if (rotationType == ROTATE_WITH_MOVEMENT) {
+			float length = std::sqrt(dx*dx + dy*dy);
+			rotate(dy / length, dx / length);
+		} else {
+			rotate(std::atan2(dy, dx));
+		}
+	}
+	/*
 	Match origin to sprite's origin.
 	*/
 	inline void rotate(std::shared_ptr<sf::Sprite> sprite) {
@@ -221,6 +273,12 @@ private:
 	float unrotatedX, unrotatedY;
 
 	float hitboxDisabledTimeLeft = 0;
+
+	/*
+	Rotate with an already known sin and cos of the angle.
+	Only applicable to ROTATE_WITH_MOVEMENT.
+	*/
+	void rotate(float sinAngle, float cosAngle);
 };
 
 class SpriteComponent {
@@ -241,13 +299,49 @@ public:
 	}
 	inline SpriteComponent(ROTATION_TYPE rotationType, std::shared_ptr<sf::Sprite> sprite, int renderLayer, float subLayer) : renderLayer(renderLayer), subLayer(subLayer), 
 		rotationType(rotationType), sprite(sprite), originalSprite(*sprite) {}
+	/*
+	Copies the sprite, animation, and effect animation so that the copy can be updated independently.
+	*/
+	SpriteComponent(const SpriteComponent& copy);
+	SpriteComponent(SpriteComponent&& other) = default;
+	SpriteComponent& operator=(SpriteComponent&& other) = default;
 
 	void update(float deltaTime);
 
 	/*
 	angle - radians in range [-pi, pi]
 	*/
-	inline void rotate(float angle) { rotationAngle = angle; }
+	inline void rotate(float angle) {
+		rotationAngle = angle;
+		rotationAngleFromMovement = false;
+	}
+	/*
+	Rotates the sprite to face a direction of movement.
+	Does nothing if the entity did not move.
+
+	dx, dy - change in position since the last update
+	*/
+	inline void rotateToMovement(float dx, float dy) {
+		if (dx == 0 && dy == 0) {
+			return;
+		}
+		if (rotationType == LOCK_ROTATION) {
+			// The angle is only needed if something inherits it, so don't calculate it until then
+			lastMovementX = dx;
+			lastMovementY = dy;
+			rotationAngleFromMovement = true;
+		} else {
+			rotate(std::atan2(dy, dx));
+		}
+	}
+	/*
+	Returns true if the sprite's transform may have changed since the last call.
+	*/
+	inline bool checkTransformChanged() {
+		bool ret = transformChanged;
+		transformChanged = false;
+		return ret;
+	}
 
 	inline int getRenderLayer() const { return renderLayer; }
 	inline float getSubLayer() const { return subLayer; }
@@ -270,8 +364,15 @@ public:
 	}
 	inline void setEffectAnimation(std::unique_ptr<SpriteEffectAnimation> effectAnimation) { this->effectAnimation = std::move(effectAnimation); }
 	// Angle in degrees
-	inline void setRotation(float angle) { sprite->setRotation(angle); }
-	inline void setScale(float x, float y) { sprite->setScale(x, y); }
+	inline void setRotation(float angle) {
+		sprite->setRotation(angle);
+		rotationApplied = false;
+		transformChanged = true;
+	}
+	inline void setScale(float x, float y) {
+		sprite->setScale(x, y);
+		transformChanged = true;
+	}
 	inline bool usesShader() {
 		if (effectAnimation == nullptr) {
 			return false;
@@ -282,6 +383,7 @@ public:
 		assert(effectAnimation != nullptr);
 		return effectAnimation->getShader();
 	}
+	inline std::shared_ptr<SpriteEffectAnimation> getEffectAnimation() { return effectAnimation; }
 	inline ROTATION_TYPE getRotationType() { return rotationType; }
 	/*
 	Returns the angle of rotation of the sprite for the purpose of
@@ -292,6 +394,9 @@ public:
 			if (lastFacedRight) return 0;
 			return -PI;
 		}
+		if (rotationAngleFromMovement) {
+			return std::atan2(lastMovementY, lastMovementX);
+		}
 		return rotationAngle;
 	}
 
@@ -305,16 +410,30 @@ private:
 	bool lastFacedRight = true;
 	// In radians
 	float rotationAngle = 0;
+	// If true, rotationAngle is outdated and the angle is that of lastMovementX/Y instead
+	bool rotationAngleFromMovement = false;
+	float lastMovementX = 0, lastMovementY = 0;
+	// The rotationAngle that was last applied to sprite; only used for ROTATE_WITH_MOVEMENT
+	float appliedRotationAngle = 0;
+	// False if sprite's rotation has been changed or reset since the last time rotationAngle was applied to it
+	bool rotationApplied = false;
+	// Whether sprite's transform may have changed since the last checkTransformChanged() call
+	bool transformChanged = true;
 
 	std::shared_ptr<sf::Sprite> sprite;
 	// The original sprite. Used for returning to original appearance after an animation ends.
 	sf::Sprite originalSprite;
 	// Effect animation that the sprite is currently undergoing, if any
-	std::unique_ptr<SpriteEffectAnimation> effectAnimation;
+	// Shared so that a RenderSnapshot can keep its shader alive until the sprite is drawn
+	std::shared_ptr<SpriteEffectAnimation> effectAnimation;
 	// Animation that the sprite is currently undergoing, if any
 	std::unique_ptr<Animation> animation;
 
-	inline void updateSprite(sf::Sprite newSprite) { *sprite = newSprite; }
+	inline void updateSprite(sf::Sprite newSprite) {
+		*sprite = newSprite;
+		rotationApplied = false;
+		transformChanged = true;
+	}
 	inline void updateSprite(std::shared_ptr<sf::Sprite> newSprite) {
 		if (!sprite) {
 			// SpriteEffectAnimations can change SpriteComponent's Sprite, so create a new Sprite object to avoid 
@@ -323,6 +442,8 @@ private:
 			if (effectAnimation != nullptr) {
 				effectAnimation->setSpritePointer(sprite);
 			}
+			rotationApplied = false;
+			transformChanged = true;
 		} else {
 			updateSprite(*newSprite);
 		}
@@ -457,7 +578,19 @@ public:
 	std::shared_ptr<DeathAction> getCurrentDeathAnimationAction();
 	std::shared_ptr<entt::SigH<void(uint32_t, std::shared_ptr<EditorEnemyPhase>, std::shared_ptr<EnemyPhaseStartCondition>, std::shared_ptr<EnemyPhaseStartCondition>)>> getEnemyPhaseChangeSignal();
 
+	/*
+	Should be called whenever this enemy's health changes.
+	*/
+	inline void onHealthChange() { nextPhaseCheckOutdated = true; }
+	/*
+	Should be called whenever the number of enemies alive changes.
+	*/
+	inline void onEnemyCountChange() { nextPhaseCheckOutdated = true; }
+
 private:
+	// Value of the next*Time fields when there is nothing to wait for
+	static constexpr float NOTHING_SCHEDULED = std::numeric_limits<float>::max();
+
 	// Time since being spawned
 	float timeSinceSpawned = 0;
 	// Time since start of the current phase
@@ -482,6 +615,18 @@ private:
 	// Current attack index in list of attacks in current EditorAttackPattern
 	int currentAttackIndex = -1;
 
+	// Phases, attack patterns, and attacks are only checked once they are due, so that
+	// updates do no lookups for enemies that are between events
+	// Value of timeSinceAttackPattern at which the next attack is executed
+	float nextAttackTime = NOTHING_SCHEDULED;
+	// Value of timeSincePhase at which the next attack pattern starts
+	float nextAttackPatternTime = NOTHING_SCHEDULED;
+	// Value of timeSincePhase at which the next phase's start condition is satisfied,
+	// or NOTHING_SCHEDULED if the condition does not depend on time
+	float nextPhaseTime = NOTHING_SCHEDULED;
+	// Whether the next phase's start condition may have become satisfied by something other than time
+	bool nextPhaseCheckOutdated = true;
+
 	// function accepts 4 arguments: this entity, pointer to the new phase, pointer to the just-ending phase's start condition (nullptr if new phase is the first phase),
 	// and pointer to the next phase's start condition (nullptr if next phase is the last phase)
 	std::shared_ptr<entt::SigH<void(uint32_t, std::shared_ptr<EditorEnemyPhase>, std::shared_ptr<EnemyPhaseStartCondition>, std::shared_ptr<EnemyPhaseStartCondition>)>> enemyPhaseChangeSignal;
@@ -597,18 +742,33 @@ The level manager entity is destroyed and re-created on the start of a new level
 */
 class LevelManagerTag {
 public:
-	LevelManagerTag(LevelPack* levelPack, std::shared_ptr<Level> level);
+	/*
+	randomSeed - the seed of every RandomStream created for this level
+	*/
+	LevelManagerTag(LevelPack* levelPack, std::shared_ptr<Level> level, uint64_t randomSeed);
 	void update(EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry& registry, float deltaTime);
 
 	inline float getTimeSinceStartOfLevel() { return timeSinceStartOfLevel; }
 	inline float getTimeSinceLastEnemySpawn() { return timeSinceLastEnemySpawn; }
+	inline int getEnemiesAlive() { return enemiesAlive; }
+	inline uint64_t getRandomSeed() { return randomSeed; }
 	inline int getPoints() { return points; }
 	inline std::shared_ptr<Level> getLevel() { return level; }
 	LevelPack* getLevelPack();
 	std::shared_ptr<entt::SigH<void(int)>> getPointsChangeSignal();
 	std::shared_ptr<entt::SigH<void(uint32_t)>> getEnemySpawnSignal();
 
+	/*
+	Returns a new RandomStream independent of all others created for this level.
+	Streams are numbered in creation order, so a level played with the same inputs gets the same streams.
+	*/
+	inline RandomStream createRandomStream() { return RandomStream(randomSeed, randomStreamsCreated++); }
+
 	void onEnemySpawn(uint32_t enemy);
+	/*
+	Should be called whenever an enemy is despawned.
+	*/
+	void onEnemyDespawn(uint32_t enemy);
 
 	inline void addPoints(int amount) { 
 		points += amount;
@@ -633,10 +793,21 @@ private:
 	std::shared_ptr<Level> level;
 	// Current index in list of LevelEvents
 	int currentLevelEventsIndex = -1;
+	// Number of enemies currently alive
+	int enemiesAlive = 0;
+	// Time since the start of the level at which the next LevelEvent's start condition is satisfied,
+	// or a negative number if it will not be satisfied until an enemy spawns or despawns
+	float nextLevelEventTime = -1;
+	// Whether nextLevelEventTime must be recalculated before it can be used
+	bool nextLevelEventTimeOutdated = true;
 
 	// Points earned so far
 	int points = 0;
 
+	uint64_t randomSeed;
+	// Number of RandomStreams created so far; the ID of the next one
+	uint64_t randomStreamsCreated = 0;
+
 	// function accepts 1 int: number of points from the current level so far
 	std::shared_ptr<entt::SigH<void(int)>> pointsChangeSignal;
 	// function accepts 1 int: the enemy entity id that just spawned
@@ -27,6 +27,9 @@ const static int INITIAL_EDITOR_ENTITY_RESERVATION = 5000;
 // Additional amount of entities to reserve space for when current limit is exceeded
 const static int ENTITY_RESERVATION_INCREMENT = 50000;
 
+// Cell size of the smallest level of the spatial hash tables that bullets are inserted into for collision detection
+const static float SMALLEST_COLLISION_CELL_SIZE = 20.0f;
+
 // Time before an item despawns
 const static float ITEM_DESPAWN_TIME = 11.0f;
 
@@ -2,27 +2,22 @@
 #include "Components.h"
 #include "Constants.h"
 
-DebugRenderSystem::DebugRenderSystem(entt::DefaultRegistry& registry, sf::RenderWindow& window, SpriteLoader& spriteLoader, float resolutionMultiplier) : RenderSystem(registry, window, spriteLoader, resolutionMultiplier, false) {
+DebugRenderSystem::DebugRenderSystem(entt::DefaultRegistry& registry, sf::RenderWindow& window, float resolutionMultiplier) : RenderSystem(registry, window, resolutionMultiplier, false) {
 	circleFormat.setFillColor(sf::Color(sf::Color::Transparent));
 	circleFormat.setOutlineThickness(3);
 }
 
 void DebugRenderSystem::update(float deltaTime) {
-	for (int i = 0; i < layers.size(); i++) {
-		layers[i].second.clear();
-	}
+	renderQueue.clear();
 
 	auto view = registry.view<PositionComponent, SpriteComponent>(entt::persistent_t{});
 	view.each([&](auto entity, auto& position, auto& sprite) {
 		if (sprite.getSprite()) {
-			sprite.getSprite()->setPosition(position.getX() * resolutionMultiplier, (MAP_HEIGHT - position.getY()) * resolutionMultiplier);
-			layers[sprite.getRenderLayer()].second.push_back(std::ref(sprite));
+			sprite.getSprite()->setPosition(position.getX(), -position.getY());
+			renderQueue.push(sprite);
 		}
 	});
-
-	for (std::pair<int, std::vector<std::reference_wrapper<SpriteComponent>>>& pair : layers) {
-		std::sort(pair.second.begin(), pair.second.end(), SubLayerComparator());
-	}
+	renderQueue.sort();
 
 	// Move background
 	backgroundX = std::fmod((backgroundX + backgroundScrollSpeedX * deltaTime), backgroundTextureSizeX);
@@ -31,7 +26,7 @@ void DebugRenderSystem::update(float deltaTime) {
 
 	// Draw background by drawing onto the temp layer first to limit the visible part of the background to the play area
 	tempLayerTexture.clear(sf::Color::Transparent);
-	backgroundSprite.setPosition(0, -MAP_HEIGHT * resolutionMultiplier);
+	backgroundSprite.setPosition(0, -MAP_HEIGHT);
 	tempLayerTexture.draw(backgroundSprite);
 	tempLayerTexture.display();
 	sf::Sprite backgroundAsSprite(tempLayerTexture.getTexture());
@@ -40,12 +35,8 @@ void DebugRenderSystem::update(float deltaTime) {
 	window.draw(backgroundAsSprite, backgroundStates);
 
 	// Draw the layers onto the window directly
-	for (int i = 0; i < layers.size(); i++) {
-		for (SpriteComponent& sprite : layers[i].second) {
-			std::shared_ptr<sf::Sprite> spritePtr = sprite.getSprite();
-
-			window.draw(*spritePtr);
-		}
+	for (std::size_t i = 0; i < renderQueue.size(); i++) {
+		window.draw(*renderQueue.getSprite(i).getSprite(), layerToWindowTransform);
 	}
 
 	// Draw the hitboxes
@@ -64,21 +55,20 @@ void DebugRenderSystem::update(float deltaTime) {
 	});
 }
 
-void DebugRenderSystem::setResolution(SpriteLoader& spriteLoader, float resolutionMultiplier) {
-	spriteLoader.setGlobalSpriteScale(resolutionMultiplier);
+void DebugRenderSystem::setResolution(float resolutionMultiplier) {
+	this->resolutionMultiplier = resolutionMultiplier;
 
 	int newPlayAreaWidth = (int)std::round(MAP_WIDTH * resolutionMultiplier);
 	int newPlayAreaHeight = (int)std::round(MAP_HEIGHT * resolutionMultiplier);
 
-	sf::View view(sf::FloatRect(0, -newPlayAreaHeight, newPlayAreaWidth, newPlayAreaHeight));
+	sf::View view(sf::FloatRect(0, -MAP_HEIGHT, MAP_WIDTH, MAP_HEIGHT));
 	tempLayerTexture.create(newPlayAreaWidth, newPlayAreaHeight);
 	tempLayerTexture.setView(view);
+	layerToWindowTransform = sf::Transform().scale((float)newPlayAreaWidth / MAP_WIDTH, (float)newPlayAreaHeight / MAP_HEIGHT).translate(0, MAP_HEIGHT);
 
 	spriteHorizontalScale = view.getSize().x / tempLayerTexture.getSize().x;
 	spriteVerticalScale = view.getSize().y / tempLayerTexture.getSize().y;
 
-	backgroundSprite.setScale(MAP_WIDTH / backgroundTextureWidth * resolutionMultiplier, MAP_HEIGHT / backgroundTextureHeight * resolutionMultiplier);
-
 	if (onResolutionChange) {
 		onResolutionChange->publish();
 	}
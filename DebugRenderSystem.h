@@ -11,10 +11,10 @@ Render system that uses no shaders and can draw outside the play area.
 */
 class DebugRenderSystem : public RenderSystem {
 public:
-	DebugRenderSystem(entt::DefaultRegistry& registry, sf::RenderWindow& window, SpriteLoader& spriteLoader, float resolutionMultiplier);
+	DebugRenderSystem(entt::DefaultRegistry& registry, sf::RenderWindow& window, float resolutionMultiplier);
 
 	void update(float deltaTime) override;
-	void setResolution(SpriteLoader& spriteLoader, float resolutionMultiplier) override;
+	void setResolution(float resolutionMultiplier) override;
 
 private:
 	sf::CircleShape circleFormat;
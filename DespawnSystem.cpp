@@ -19,7 +19,7 @@ void DespawnSystem::update(float deltaTime) {
 			dfsInsertChildren(registry, deletionQueue, despawn.getChildren());
 
 			despawn.onDespawn(entity);
-			registry.destroy(entity);
+			destroy(entity);
 		}
 	});
 
@@ -31,7 +31,14 @@ void DespawnSystem::update(float deltaTime) {
 				despawn.removeEntityAttachment(registry, entity);
 				despawn.onDespawn(entity);
 			}
-			registry.destroy(entity);
+			destroy(entity);
 		}
 	}
 }
+
+void DespawnSystem::destroy(uint32_t entity) {
+	if (registry.has<EnemyComponent>(entity) && registry.has<LevelManagerTag>()) {
+		registry.get<LevelManagerTag>().onEnemyDespawn(entity);
+	}
+	registry.destroy(entity);
+}
@@ -12,4 +12,6 @@ public:
 
 private:
 	entt::DefaultRegistry& registry;
+
+	void destroy(uint32_t entity);
 };
\ No newline at end of file
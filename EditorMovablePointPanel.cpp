@@ -1,16 +1,33 @@
 #include "EditorMovablePointPanel.h"
+#include "Constants.h"
 
 EditorMovablePointPanel::EditorMovablePointPanel(EditorWindow & parentWindow, LevelPack & levelPack, std::shared_ptr<EditorMovablePoint> emp) : parentWindow(parentWindow), levelPack(levelPack), emp(emp) {
 	tabs = TabsWithPanel::create(parentWindow);
 	tabs->setPosition(0, 0);
 	tabs->setSize("100%", "100%");
 	add(tabs);
+
+	std::shared_ptr<tgui::Panel> pathPanel = tgui::Panel::create();
+	pathGraph = EMPPathGraph::create();
+	pathGraph->setPosition(0, 0);
+	pathGraph->setSize("100%", "100%");
+	pathPanel->add(pathGraph);
+	tabs->addTab("Path", pathPanel, false);
+	updatePathGraph();
+	onEMPModify.connect([this]() {
+		updatePathGraph();
+	});
 }
 
 bool EditorMovablePointPanel::handleEvent(sf::Event event) {
 	return false;
 }
 
+void EditorMovablePointPanel::updatePathGraph() {
+	// The EMP's spawn position depends on its parent, so the path is shown from the middle of the map
+	pathGraph->setPath(emp->getActions(), MAP_WIDTH / 2.0f, MAP_HEIGHT / 2.0f, PLAYER_SPAWN_X, PLAYER_SPAWN_Y);
+}
+
 tgui::Signal & EditorMovablePointPanel::getSignal(std::string signalName) {
 	if (signalName == tgui::toLower(onEMPModify.getName())) {
 		return onEMPModify;
@@ -31,10 +31,14 @@ private:
 	std::shared_ptr<EditorMovablePoint> emp;
 
 	std::shared_ptr<TabsWithPanel> tabs;
+	// Shows the path of the EMP's actions
+	std::shared_ptr<EMPPathGraph> pathGraph;
 
 	/*
 	Signal emitted when the EMP being edited is modified.
 	Optional parameter: a shared_ptr to the newly modified EditorMovablePoint
 	*/
 	tgui::SignalEditorMovablePoint onEMPModify = { "EMPModified" };
+
+	void updatePathGraph();
 };
\ No newline at end of file
@@ -5,8 +5,11 @@
 #include <boost/filesystem.hpp>
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cctype>
+#include <set>
 #include "Level.h"
-#include "matplotlibcpp.h"
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -105,36 +108,31 @@ sf::VertexArray generateVertexArray(std::shared_ptr<EMPAction> action, float tim
 	return ret;
 }
 
-std::vector<std::pair<std::vector<float>, std::vector<float>>> generateMPLPoints(std::shared_ptr<PiecewiseTFV> tfv, float tfvLifespan, float timeResolution) {
-	std::vector<std::pair<std::vector<float>, std::vector<float>>> ret;
-	float time = 0;
-	int prevSegmentIndex = -1;
-	float lowestY = 2147483647;
-	float highestY = -2147483647;
-	std::vector<float> singleSegmentX;
-	std::vector<float> singleSegmentY;
-	while (time < tfvLifespan) {
-		std::pair<float, int> valueAndSegmentIndex = tfv->piecewiseEvaluate(time);
-		sf::Vector2f pos(time, valueAndSegmentIndex.first);
-
-		if (valueAndSegmentIndex.second != prevSegmentIndex) {
-			if (prevSegmentIndex != -1) {
-				ret.push_back(std::make_pair(singleSegmentX, singleSegmentY));
-				singleSegmentX.clear();
-				singleSegmentY.clear();
-			}
-
-			prevSegmentIndex = valueAndSegmentIndex.second;
+int fuzzyMatchScore(const std::string& pattern, const std::string& text) {
+	int score = 0;
+	int textIndex = 0;
+	bool previousMatched = false;
+	for (char c : pattern) {
+		char lower = std::tolower((unsigned char)c);
+		while (textIndex < text.size() && std::tolower((unsigned char)text[textIndex]) != lower) {
+			textIndex++;
+			previousMatched = false;
+		}
+		if (textIndex == text.size()) {
+			return -1;
 		}
-		lowestY = std::min(lowestY, valueAndSegmentIndex.first);
-		highestY = std::max(highestY, valueAndSegmentIndex.first);
 
-		singleSegmentX.push_back(pos.x);
-		singleSegmentY.push_back(pos.y);
-		time += timeResolution;
+		score++;
+		if (previousMatched) {
+			score += 2;
+		}
+		if (textIndex == 0 || !std::isalnum((unsigned char)text[textIndex - 1])) {
+			score += 3;
+		}
+		previousMatched = true;
+		textIndex++;
 	}
-	ret.push_back(std::make_pair(singleSegmentX, singleSegmentY));
-	return ret;
+	return score;
 }
 
 
@@ -768,24 +766,326 @@ void NumericalEditBoxWithLimits::updateInputValidator() {
 	}
 }
 
+TFVGraph::TFVGraph() {
+}
+
+TFVGraph::~TFVGraph() {
+	cancel();
+}
+
+void TFVGraph::setTFV(std::shared_ptr<PiecewiseTFV> tfv, float tfvLifespan) {
+	std::string cacheKey = tfv->format() + "|" + std::to_string(tfvLifespan);
+	if (cacheKey == currentCacheKey) {
+		// Already being graphed or already graphed
+		return;
+	}
+	cancel();
+	currentCacheKey = cacheKey;
+
+	if (tfvLifespan <= 0) {
+		// Nothing to graph
+		std::lock_guard<std::mutex> lock(pointsMutex);
+		points = nullptr;
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(pointsMutex);
+		std::shared_ptr<GraphPoints> cachedPoints;
+		if (cache.tryGet(cacheKey, cachedPoints)) {
+			points = cachedPoints;
+			return;
+		}
+	}
+
+	cancelled = std::make_shared<std::atomic<bool>>(false);
+	// The TFV is cloned here since the original is modified on this thread
+	worker = std::thread(&TFVGraph::sample, this, std::dynamic_pointer_cast<PiecewiseTFV>(tfv->clone()), tfvLifespan, cacheKey, cancelled);
+}
+
+void TFVGraph::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	tgui::Panel::draw(target, states);
+
+	std::shared_ptr<GraphPoints> graphPoints;
+	{
+		std::lock_guard<std::mutex> lock(pointsMutex);
+		graphPoints = points;
+	}
+	if (!graphPoints || graphPoints->lifespan <= 0) {
+		return;
+	}
+
+	states.transform.translate(getPosition());
+	sf::Vector2f size = getSize();
+	float valueRange = graphPoints->highestValue - graphPoints->lowestValue;
+	for (int i = 0; i < graphPoints->segments.size(); i++) {
+		const std::vector<float>& times = graphPoints->segments[i].first;
+		const std::vector<float>& values = graphPoints->segments[i].second;
+		sf::Color color = (i % 2 == 0) ? sf::Color::Red : sf::Color::Blue;
+
+		sf::VertexArray line(sf::LineStrip, times.size());
+		for (int j = 0; j < times.size(); j++) {
+			float x = times[j] / graphPoints->lifespan * size.x;
+			// A constant TFV is drawn through the middle
+			float y = (valueRange == 0) ? size.y / 2.0f : size.y - (values[j] - graphPoints->lowestValue) / valueRange * size.y;
+			line[j] = sf::Vertex(sf::Vector2f(x, y), color);
+		}
+		target.draw(line, states);
+	}
+}
+
+void TFVGraph::cancel() {
+	if (cancelled) {
+		*cancelled = true;
+	}
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+void TFVGraph::sample(std::shared_ptr<PiecewiseTFV> tfv, float tfvLifespan, std::string cacheKey, std::shared_ptr<std::atomic<bool>> cancelled) {
+	// The time resolution would be 0/0
+	if (tfvLifespan <= 0) {
+		return;
+	}
+
+	std::vector<float> segmentStartTimes;
+	for (int i = 1; i < tfv->getSegmentsCount(); i++) {
+		segmentStartTimes.push_back(tfv->getSegment(i).first);
+	}
+
+	float timeResolution = tfvLifespan / FIRST_PASS_SAMPLES;
+	std::vector<float> times;
+	while (true) {
+		times.clear();
+		int uniformSamples = (int)std::ceil(tfvLifespan / timeResolution);
+		for (int i = 0; i < uniformSamples; i++) {
+			times.push_back(i * timeResolution);
+		}
+		times.push_back(tfvLifespan);
+		for (float startTime : segmentStartTimes) {
+			times.push_back(startTime - BOUNDARY_EPSILON);
+			times.push_back(startTime);
+			for (int i = 1; i <= BOUNDARY_SAMPLES; i++) {
+				float offset = timeResolution * i / (BOUNDARY_SAMPLES + 1);
+				times.push_back(startTime - offset);
+				times.push_back(startTime + offset);
+			}
+		}
+		std::sort(times.begin(), times.end());
+		times.erase(std::unique(times.begin(), times.end()), times.end());
+
+		std::shared_ptr<GraphPoints> graphPoints = std::make_shared<GraphPoints>();
+		graphPoints->lifespan = tfvLifespan;
+		graphPoints->lowestValue = std::numeric_limits<float>::max();
+		graphPoints->highestValue = std::numeric_limits<float>::lowest();
+		int prevSegmentIndex = -1;
+		for (int i = 0; i < times.size(); i++) {
+			if (i % CANCEL_CHECK_INTERVAL == 0 && *cancelled) {
+				return;
+			}
+			if (times[i] < 0 || times[i] > tfvLifespan) {
+				continue;
+			}
+
+			std::pair<float, int> valueAndSegmentIndex = tfv->piecewiseEvaluate(times[i]);
+			if (valueAndSegmentIndex.second != prevSegmentIndex) {
+				graphPoints->segments.push_back(std::make_pair(std::vector<float>(), std::vector<float>()));
+				prevSegmentIndex = valueAndSegmentIndex.second;
+			}
+			graphPoints->segments.back().first.push_back(times[i]);
+			graphPoints->segments.back().second.push_back(valueAndSegmentIndex.first);
+			graphPoints->lowestValue = std::min(graphPoints->lowestValue, valueAndSegmentIndex.first);
+			graphPoints->highestValue = std::max(graphPoints->highestValue, valueAndSegmentIndex.first);
+		}
+
+		bool lastPass = times.size() >= MAX_SAMPLES || timeResolution <= FINEST_TIME_RESOLUTION;
+		{
+			std::lock_guard<std::mutex> lock(pointsMutex);
+			if (*cancelled) {
+				return;
+			}
+			points = graphPoints;
+			if (lastPass) {
+				cache.insert(cacheKey, graphPoints);
+			}
+		}
+		if (lastPass) {
+			return;
+		}
+		timeResolution /= 2;
+	}
+}
+
+EMPPathGraph::EMPPathGraph() {
+}
+
+EMPPathGraph::~EMPPathGraph() {
+	cancel();
+}
+
+void EMPPathGraph::setPath(std::vector<std::shared_ptr<EMPAction>> actions, float x, float y, float playerX, float playerY) {
+	std::string cacheKey = std::to_string(x) + "|" + std::to_string(y) + "|" + std::to_string(playerX) + "|" + std::to_string(playerY);
+	for (auto action : actions) {
+		cacheKey += "|" + action->format();
+	}
+	if (cacheKey == currentCacheKey) {
+		// Already being graphed or already graphed
+		return;
+	}
+	cancel();
+	currentCacheKey = cacheKey;
+
+	{
+		std::lock_guard<std::mutex> lock(pointsMutex);
+		std::shared_ptr<PathPoints> cachedPoints;
+		if (cache.tryGet(cacheKey, cachedPoints)) {
+			points = cachedPoints;
+			return;
+		}
+		points = nullptr;
+	}
+
+	// The actions are cloned here since the originals are modified on this thread
+	std::vector<std::shared_ptr<EMPAction>> actionsCopy;
+	for (auto action : actions) {
+		actionsCopy.push_back(action->clone());
+	}
+	cancelled = std::make_shared<std::atomic<bool>>(false);
+	worker = std::thread(&EMPPathGraph::sample, this, actionsCopy, x, y, playerX, playerY, cacheKey, cancelled);
+}
+
+void EMPPathGraph::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	tgui::Panel::draw(target, states);
+
+	std::shared_ptr<PathPoints> pathPoints;
+	{
+		std::lock_guard<std::mutex> lock(pointsMutex);
+		pathPoints = points;
+	}
+	if (!pathPoints || pathPoints->positions.size() < 2) {
+		return;
+	}
+
+	// Keep the aspect ratio of the path; a path that is a single point or a straight line is centered
+	sf::Vector2f size = getSize();
+	const sf::FloatRect& bounds = pathPoints->bounds;
+	float scale = std::numeric_limits<float>::max();
+	if (bounds.width > 0) {
+		scale = std::min(scale, size.x / bounds.width);
+	}
+	if (bounds.height > 0) {
+		scale = std::min(scale, size.y / bounds.height);
+	}
+	if (scale == std::numeric_limits<float>::max()) {
+		scale = 1;
+	}
+	sf::Vector2f center(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+
+	states.transform.translate(getPosition());
+	sf::VertexArray line(sf::LineStrip, pathPoints->positions.size());
+	for (int i = 0; i < pathPoints->positions.size(); i++) {
+		float progress = (pathPoints->totalTime == 0) ? 0 : pathPoints->times[i] / pathPoints->totalTime;
+		sf::Color color((sf::Uint8)(255 * (1 - progress)), 0, (sf::Uint8)(255 * progress));
+		// Positive y is up in the game but down on the screen
+		sf::Vector2f pos = pathPoints->positions[i] - center;
+		line[i] = sf::Vertex(sf::Vector2f(size.x / 2.0f + pos.x * scale, size.y / 2.0f - pos.y * scale), color);
+	}
+	target.draw(line, states);
+}
+
+void EMPPathGraph::cancel() {
+	if (cancelled) {
+		*cancelled = true;
+	}
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+void EMPPathGraph::sample(std::vector<std::shared_ptr<EMPAction>> actions, float x, float y, float playerX, float playerY, std::string cacheKey, std::shared_ptr<std::atomic<bool>> cancelled) {
+	float totalTime = 0;
+	for (auto action : actions) {
+		totalTime += action->getTime();
+	}
+
+	// Every action is always sampled at least at its start and end, so a path with no duration still has points
+	float timeResolution = (totalTime > 0) ? totalTime / FIRST_PASS_SAMPLES : FINEST_TIME_RESOLUTION;
+	while (true) {
+		std::shared_ptr<PathPoints> pathPoints = std::make_shared<PathPoints>();
+		pathPoints->totalTime = totalTime;
+
+		float curX = x, curY = y;
+		float actionStartTime = 0;
+		int samplesCount = 0;
+		for (auto action : actions) {
+			std::shared_ptr<MovablePoint> mp = action->generateStandaloneMP(curX, curY, playerX, playerY);
+			float actionTime = action->getTime();
+			int uniformSamples = (int)std::ceil(actionTime / timeResolution);
+			for (int i = 0; i <= uniformSamples; i++) {
+				if (samplesCount++ % CANCEL_CHECK_INTERVAL == 0 && *cancelled) {
+					return;
+				}
+				float time = std::min(i * timeResolution, actionTime);
+				pathPoints->positions.push_back(mp->compute(sf::Vector2f(0, 0), time) + sf::Vector2f(curX, curY));
+				pathPoints->times.push_back(actionStartTime + time);
+			}
+
+			sf::Vector2f end = mp->compute(sf::Vector2f(0, 0), mp->getLifespan());
+			curX += end.x;
+			curY += end.y;
+			actionStartTime += actionTime;
+		}
+
+		if (!pathPoints->positions.empty()) {
+			float left = pathPoints->positions[0].x, right = left;
+			float bottom = pathPoints->positions[0].y, top = bottom;
+			for (const sf::Vector2f& pos : pathPoints->positions) {
+				left = std::min(left, pos.x);
+				right = std::max(right, pos.x);
+				bottom = std::min(bottom, pos.y);
+				top = std::max(top, pos.y);
+			}
+			pathPoints->bounds = sf::FloatRect(left, bottom, right - left, top - bottom);
+		}
+
+		bool lastPass = totalTime <= 0 || samplesCount >= MAX_SAMPLES || timeResolution <= FINEST_TIME_RESOLUTION;
+		{
+			std::lock_guard<std::mutex> lock(pointsMutex);
+			if (*cancelled) {
+				return;
+			}
+			points = pathPoints;
+			if (lastPass) {
+				cache.insert(cacheKey, pathPoints);
+			}
+		}
+		if (lastPass) {
+			return;
+		}
+		timeResolution /= 2;
+	}
+}
+
 TFVGroup::TFVGroup(EditorWindow& parentWindow) : parentWindow(parentWindow) {
 	showGraph = tgui::Button::create();
 	showGraph->setText("Show graph");
 	showGraph->connect("Pressed", [&]() {
-		auto points = generateMPLPoints(tfv, tfvLifespan, TFV_TIME_RESOLUTION);
-		matplotlibcpp::clf();
-		matplotlibcpp::close();
-		for (int i = 0; i < points.size(); i++) {
-			if (i % 2 == 0) {
-				matplotlibcpp::plot(points[i].first, points[i].second, "r");
-			} else {
-				matplotlibcpp::plot(points[i].first, points[i].second, "b");
-			}
-		}
-		matplotlibcpp::show();
+		graph->setVisible(!graph->isVisible());
+		showGraph->setText(graph->isVisible() ? "Hide graph" : "Show graph");
+		updateGraph();
+		// Resize to fit the graph
+		setSize(getSizeLayout());
 	});
 	add(showGraph);
 
+	graph = TFVGraph::create();
+	graph->setVisible(false);
+	add(graph);
+	onValueChange.connect([this](std::pair<std::shared_ptr<TFV>, std::shared_ptr<TFV>> tfvs) {
+		updateGraph();
+	});
+
 	addSegment = tgui::Button::create();
 	addSegment->setText("Add");
 	addSegment->connect("Pressed", [&]() {
@@ -1097,6 +1397,9 @@ TFVGroup::TFVGroup(EditorWindow& parentWindow) : parentWindow(parentWindow) {
 		changeSegmentType->setSize(buttonWidth, TEXT_BUTTON_HEIGHT);
 		changeSegmentType->setPosition(tgui::bindRight(deleteSegment) + GUI_PADDING_X, tgui::bindTop(deleteSegment));
 
+		graph->setSize(newSize.x, TFV_GRAPH_HEIGHT);
+		graph->setPosition(0, changeSegmentType->getPosition().y + changeSegmentType->getSize().y + GUI_PADDING_Y);
+
 		int segmentListRightBoundary = segmentList->getPosition().x + segmentList->getSize().x + GUI_PADDING_X;
 
 		startTime->setSize(newSize.x - (segmentListRightBoundary + GUI_PADDING_X * 2), TEXT_BOX_HEIGHT);
@@ -1125,7 +1428,11 @@ TFVGroup::TFVGroup(EditorWindow& parentWindow) : parentWindow(parentWindow) {
 		tfvInt1Slider->setPosition(segmentListRightBoundary, tgui::bindBottom(tfvInt1Label) + GUI_LABEL_PADDING_Y);
 
 		segmentList->setSize(segmentList->getSize().x, tgui::bindBottom(this->tfvInt1Slider));
-		this->setSize(this->getSizeLayout().x, changeSegmentType->getPosition().y + changeSegmentType->getSize().y);
+		if (graph->isVisible()) {
+			this->setSize(this->getSizeLayout().x, graph->getPosition().y + graph->getSize().y);
+		} else {
+			this->setSize(this->getSizeLayout().x, changeSegmentType->getPosition().y + changeSegmentType->getSize().y);
+		}
 		ignoreResizeSignal = false;
 	});
 
@@ -1315,6 +1622,15 @@ void TFVGroup::populateSegmentList() {
 		segmentList->getListBox()->setSelectedItemById(selectedIndexString);
 	}
 	ignoreSignals = false;
+
+	updateGraph();
+}
+
+void TFVGroup::updateGraph() {
+	if (graph->isVisible()) {
+		std::lock_guard<std::recursive_mutex> lock(tfvMutex);
+		graph->setTFV(tfv, tfvLifespan);
+	}
 }
 
 EMPAAngleOffsetGroup::EMPAAngleOffsetGroup(EditorWindow & parentWindow) : parentWindow(parentWindow) {
@@ -1473,26 +1789,46 @@ void EMPAAngleOffsetGroup::updateWidgets() {
 	ignoreSignals = false;
 }
 
+TextWidthChecker::TextWidthChecker() : cache(CACHE_SIZE, CACHE_SIZE / 8) {
+	label = tgui::Label::create();
+	label->setMaximumTextWidth(0);
+}
+
+float TextWidthChecker::getWidth(const std::string& text) {
+	float width;
+	if (!cache.tryGet(text, width)) {
+		label->setText(text);
+		width = label->getSize().x;
+		cache.insert(text, width);
+	}
+	return width;
+}
+
+void TextWidthChecker::setTextSize(int textSize) {
+	label->setTextSize(textSize);
+	cache.clear();
+}
+
 ListBoxScrollablePanel::ListBoxScrollablePanel() {
 	listBox = tgui::ListBox::create();
 	add(listBox);
 	listBox->setSize("100%", "100%");
 
-	textWidthChecker = tgui::Label::create();
-	textWidthChecker->setMaximumTextWidth(0);
-
 	connect("SizeChanged", [&]() {
-		onListBoxItemsUpdate();
+		updateListBoxWidth();
 	});
 }
 
 void ListBoxScrollablePanel::onListBoxItemsUpdate() {
-	float largestWidth = 0;
+	largestItemWidth = 0;
 	for (auto str : listBox->getItems()) {
-		textWidthChecker->setText(str);
-		largestWidth = std::max(largestWidth, textWidthChecker->getSize().x);
+		largestItemWidth = std::max(largestItemWidth, textWidthChecker.getWidth(str));
 	}
-	listBox->setSize(std::max(getSize().x, largestWidth), "100%");
+	updateListBoxWidth();
+}
+
+void ListBoxScrollablePanel::updateListBoxWidth() {
+	listBox->setSize(std::max(getSize().x, largestItemWidth), "100%");
 }
 
 bool ListBoxScrollablePanel::mouseWheelScrolled(float delta, tgui::Vector2f pos) {
@@ -1519,7 +1855,8 @@ bool ListBoxScrollablePanel::mouseWheelScrolled(float delta, tgui::Vector2f pos)
 
 void ListBoxScrollablePanel::setTextSize(int textSize) {
 	listBox->setTextSize(textSize);
-	textWidthChecker->setTextSize(textSize);
+	textWidthChecker.setTextSize(textSize);
+	onListBoxItemsUpdate();
 }
 
 ListViewScrollablePanel::ListViewScrollablePanel() {
@@ -1527,20 +1864,211 @@ ListViewScrollablePanel::ListViewScrollablePanel() {
 	add(listView);
 	listView->setSize("100%", "100%");
 
-	textWidthChecker = tgui::Label::create();
-	textWidthChecker->setMaximumTextWidth(0);
-
 	connect("SizeChanged", [&]() {
-		onListViewItemsUpdate();
+		updateListViewWidth();
 	});
 }
 
 void ListViewScrollablePanel::onListViewItemsUpdate() {
-	float largestWidth = 0;
+	itemWidths.clear();
 	for (auto str : listView->getItems()) {
-		textWidthChecker->setText(str);
-		largestWidth = std::max(largestWidth, textWidthChecker->getSize().x);
+		itemWidths.insert(textWidthChecker.getWidth(str));
+	}
+	updateListViewWidth();
+}
+
+void ListViewScrollablePanel::insertItem(int unfilteredIndex, const sf::String& item) {
+	if (filter == "") {
+		insertShownItem(unfilteredIndex, item);
+		return;
+	}
+
+	unfilteredItems.insert(unfilteredItems.begin() + unfilteredIndex, item);
+	filteredIndices.insert(filteredIndices.begin() + unfilteredIndex, -1);
+	for (int& i : unfilteredIndices) {
+		if (i >= unfilteredIndex) {
+			i++;
+		}
+	}
+
+	int score = fuzzyMatchScore(filter, item);
+	if (score < 0) {
+		return;
+	}
+	// Shown items are ordered by descending score, then by unfiltered index
+	int index = 0;
+	int high = unfilteredIndices.size();
+	while (index < high) {
+		int mid = (index + high) / 2;
+		if (shownScores[mid] > score || (shownScores[mid] == score && unfilteredIndices[mid] < unfilteredIndex)) {
+			index = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	unfilteredIndices.insert(unfilteredIndices.begin() + index, unfilteredIndex);
+	shownScores.insert(shownScores.begin() + index, score);
+	for (int& i : filteredIndices) {
+		if (i >= index) {
+			i++;
+		}
+	}
+	filteredIndices[unfilteredIndex] = index;
+	insertShownItem(index, item);
+}
+
+void ListViewScrollablePanel::removeItem(int unfilteredIndex) {
+	int index = unfilteredIndex;
+	if (filter != "") {
+		index = filteredIndices[unfilteredIndex];
+		unfilteredItems.erase(unfilteredItems.begin() + unfilteredIndex);
+		filteredIndices.erase(filteredIndices.begin() + unfilteredIndex);
+		for (int& i : unfilteredIndices) {
+			if (i > unfilteredIndex) {
+				i--;
+			}
+		}
+		if (index < 0) {
+			return;
+		}
+		unfilteredIndices.erase(unfilteredIndices.begin() + index);
+		shownScores.erase(shownScores.begin() + index);
+		for (int& i : filteredIndices) {
+			if (i > index) {
+				i--;
+			}
+		}
+	}
+
+	auto it = itemWidths.find(textWidthChecker.getWidth(listView->getItem(index)));
+	if (it != itemWidths.end()) {
+		itemWidths.erase(it);
+	}
+	listView->removeItem(index);
+	updateListViewWidth();
+}
+
+void ListViewScrollablePanel::changeItem(int unfilteredIndex, const sf::String& item) {
+	if (filter == "") {
+		changeShownItem(unfilteredIndex, item);
+		return;
+	}
+
+	int index = filteredIndices[unfilteredIndex];
+	int oldScore = (index < 0 ? -1 : shownScores[index]);
+	int score = std::max(fuzzyMatchScore(filter, item), -1);
+	if (score != oldScore) {
+		// The item is shown, hidden, or moved
+		removeItem(unfilteredIndex);
+		insertItem(unfilteredIndex, item);
+		return;
+	}
+	unfilteredItems[unfilteredIndex] = item;
+	if (index >= 0) {
+		changeShownItem(index, item);
+	}
+}
+
+void ListViewScrollablePanel::insertShownItem(int index, const sf::String& item) {
+	listView->addItem(item);
+	int lastIndex = listView->getItemCount() - 1;
+	if (index < lastIndex) {
+		// The ListView can only add items to the end, so every item from index onwards is moved down by one
+		// by changing their text, which is still much faster than adding every item again
+		std::set<std::size_t> selectedIndices;
+		for (std::size_t selectedIndex : listView->getSelectedItemIndices()) {
+			selectedIndices.insert(selectedIndex >= (std::size_t)index ? selectedIndex + 1 : selectedIndex);
+		}
+		for (int i = lastIndex; i > index; i--) {
+			listView->changeItem(i, { listView->getItem(i - 1) });
+		}
+		listView->changeItem(index, { item });
+		listView->setSelectedItems(selectedIndices);
+	}
+	itemWidths.insert(textWidthChecker.getWidth(item));
+	updateListViewWidth();
+}
+
+void ListViewScrollablePanel::changeShownItem(int index, const sf::String& item) {
+	auto it = itemWidths.find(textWidthChecker.getWidth(listView->getItem(index)));
+	if (it != itemWidths.end()) {
+		itemWidths.erase(it);
+	}
+	listView->changeItem(index, { item });
+	itemWidths.insert(textWidthChecker.getWidth(item));
+	updateListViewWidth();
+}
+
+void ListViewScrollablePanel::setFilter(const std::string& filter) {
+	if (filter == this->filter) {
+		return;
+	}
+	if (this->filter == "") {
+		unfilteredItems = listView->getItems();
 	}
+	std::set<int> selectedUnfilteredIndices;
+	for (std::size_t index : listView->getSelectedItemIndices()) {
+		selectedUnfilteredIndices.insert(getUnfilteredIndex(index));
+	}
+	this->filter = filter;
+
+	listView->removeAllItems();
+	unfilteredIndices.clear();
+	shownScores.clear();
+	filteredIndices.clear();
+	if (filter == "") {
+		for (auto& item : unfilteredItems) {
+			listView->addItem(item);
+		}
+		unfilteredItems.clear();
+	} else {
+		// Pairs of score and index in unfilteredItems
+		std::vector<std::pair<int, int>> matches;
+		for (int i = 0; i < unfilteredItems.size(); i++) {
+			int score = fuzzyMatchScore(filter, unfilteredItems[i]);
+			if (score >= 0) {
+				matches.push_back(std::make_pair(score, i));
+			}
+		}
+		std::stable_sort(matches.begin(), matches.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+			return a.first > b.first;
+		});
+		filteredIndices.resize(unfilteredItems.size(), -1);
+		for (auto& match : matches) {
+			filteredIndices[match.second] = unfilteredIndices.size();
+			listView->addItem(unfilteredItems[match.second]);
+			unfilteredIndices.push_back(match.second);
+			shownScores.push_back(match.first);
+		}
+	}
+
+	std::set<std::size_t> selectedIndices;
+	for (int unfilteredIndex : selectedUnfilteredIndices) {
+		int index = getFilteredIndex(unfilteredIndex);
+		if (index >= 0) {
+			selectedIndices.insert(index);
+		}
+	}
+	listView->setSelectedItems(selectedIndices);
+	onListViewItemsUpdate();
+}
+
+int ListViewScrollablePanel::getUnfilteredIndex(int index) const {
+	if (filter == "") {
+		return index;
+	}
+	return unfilteredIndices[index];
+}
+
+int ListViewScrollablePanel::getFilteredIndex(int unfilteredIndex) const {
+	if (filter == "") {
+		return unfilteredIndex;
+	}
+	return filteredIndices[unfilteredIndex];
+}
+
+void ListViewScrollablePanel::updateListViewWidth() {
+	float largestWidth = itemWidths.empty() ? 0 : *itemWidths.rbegin();
 	listView->setSize(std::max(getSize().x, largestWidth), "100%");
 }
 
@@ -1568,7 +2096,8 @@ bool ListViewScrollablePanel::mouseWheelScrolled(float delta, tgui::Vector2f pos
 
 void ListViewScrollablePanel::setTextSize(int textSize) {
 	listView->setTextSize(textSize);
-	textWidthChecker->setTextSize(textSize);
+	textWidthChecker.setTextSize(textSize);
+	onListViewItemsUpdate();
 }
 
 void Slider::setValue(float value) {
@@ -1599,6 +2128,7 @@ SimpleEngineRenderer::SimpleEngineRenderer(sf::RenderWindow & parentWindow, bool
 paused(true), userControlledView(userControlledView), useDebugRenderSystem(useDebugRenderSystem) {
 	audioPlayer = std::make_unique<AudioPlayer>();
 	queue = std::make_unique<EntityCreationQueue>(registry);
+	keyboardInput.setPaused(paused);
 
 	if (userControlledView) {
 		viewController = std::make_unique<ViewController>(parentWindow);
@@ -1680,6 +2210,7 @@ void SimpleEngineRenderer::draw(sf::RenderTarget & target, sf::RenderStates stat
 }
 
 bool SimpleEngineRenderer::handleEvent(sf::Event event) {
+	keyboardInput.handleEvent(event);
 	if (viewController) {
 		return viewController->handleEvent(viewFromViewController, event);
 	}
@@ -1696,9 +2227,9 @@ void SimpleEngineRenderer::loadLevelPack(std::string name) {
 	movementSystem = std::make_unique<MovementSystem>(*queue, *spriteLoader, registry);
 	//TODO: these numbers should come from settings
 	if (useDebugRenderSystem) {
-		renderSystem = std::make_unique<DebugRenderSystem>(registry, parentWindow, *spriteLoader, 1.0f);
+		renderSystem = std::make_unique<DebugRenderSystem>(registry, parentWindow, 1.0f);
 	} else {
-		renderSystem = std::make_unique<RenderSystem>(registry, parentWindow, *spriteLoader, 1.0f);
+		renderSystem = std::make_unique<RenderSystem>(registry, parentWindow, 1.0f);
 	}
 	collisionSystem = std::make_unique<CollisionSystem>(*levelPack, *queue, *spriteLoader, registry, MAP_WIDTH, MAP_HEIGHT);
 	despawnSystem = std::make_unique<DespawnSystem>(registry);
@@ -1706,7 +2237,7 @@ void SimpleEngineRenderer::loadLevelPack(std::string name) {
 	spriteAnimationSystem = std::make_unique<SpriteAnimationSystem>(*spriteLoader, registry);
 	shadowTrailSystem = std::make_unique<ShadowTrailSystem>(*queue, registry);
 	playerSystem = std::make_unique<PlayerSystem>(*levelPack, *queue, *spriteLoader, registry);
-	collectibleSystem = std::make_unique<CollectibleSystem>(*queue, registry, *levelPack, MAP_WIDTH, MAP_HEIGHT);
+	collectibleSystem = std::make_unique<CollectibleSystem>(*queue, registry, MAP_WIDTH, MAP_HEIGHT);
 
 	renderSystem->getOnResolutionChange()->sink().connect<SimpleEngineRenderer, &SimpleEngineRenderer::updateWindowView>(this);
 	updateWindowView();
@@ -1719,9 +2250,9 @@ void SimpleEngineRenderer::loadLevelPack(std::shared_ptr<LevelPack> levelPack) {
 	movementSystem = std::make_unique<MovementSystem>(*queue, *spriteLoader, registry);
 	//TODO: these numbers should come from settings
 	if (useDebugRenderSystem) {
-		renderSystem = std::make_unique<DebugRenderSystem>(registry, parentWindow, *spriteLoader, 1.0f);
+		renderSystem = std::make_unique<DebugRenderSystem>(registry, parentWindow, 1.0f);
 	} else {
-		renderSystem = std::make_unique<RenderSystem>(registry, parentWindow, *spriteLoader, 1.0f);
+		renderSystem = std::make_unique<RenderSystem>(registry, parentWindow, 1.0f);
 	}
 	collisionSystem = std::make_unique<CollisionSystem>(*levelPack, *queue, *spriteLoader, registry, MAP_WIDTH, MAP_HEIGHT);
 	despawnSystem = std::make_unique<DespawnSystem>(registry);
@@ -1729,7 +2260,7 @@ void SimpleEngineRenderer::loadLevelPack(std::shared_ptr<LevelPack> levelPack) {
 	spriteAnimationSystem = std::make_unique<SpriteAnimationSystem>(*spriteLoader, registry);
 	shadowTrailSystem = std::make_unique<ShadowTrailSystem>(*queue, registry);
 	playerSystem = std::make_unique<PlayerSystem>(*levelPack, *queue, *spriteLoader, registry);
-	collectibleSystem = std::make_unique<CollectibleSystem>(*queue, registry, *levelPack, MAP_WIDTH, MAP_HEIGHT);
+	collectibleSystem = std::make_unique<CollectibleSystem>(*queue, registry, MAP_WIDTH, MAP_HEIGHT);
 
 	renderSystem->getOnResolutionChange()->sink().connect<SimpleEngineRenderer, &SimpleEngineRenderer::updateWindowView>(this);
 	updateWindowView();
@@ -1743,18 +2274,28 @@ void SimpleEngineRenderer::loadLevel(int levelIndex) {
 }
 
 void SimpleEngineRenderer::loadLevel(std::shared_ptr<Level> level) {
+	const LevelProfile& levelProfile = levelPack->getLevelProfile(level);
+	collisionSystem->loadLevelProfile(levelProfile);
+	collectibleSystem->loadLevelProfile(levelProfile);
+	for (std::string soundFileName : levelProfile.soundFileNames) {
+		levelPack->preloadSound(soundFileName);
+	}
+
 	// Load bloom settings
 	renderSystem->loadLevelRenderSettings(level);
 
+	movementSystem->setCullingMargin(level->getCullingMargin());
+
 	// Remove all existing entities from the registry
 	registry.reset();
-	reserveMemory(registry, INITIAL_EDITOR_ENTITY_RESERVATION);
+	reserveMemory(registry, std::max(INITIAL_EDITOR_ENTITY_RESERVATION, levelProfile.expectedPeakEntityCount));
 
 	// Create the level manager
 	registry.reserve<LevelManagerTag>(1);
 	registry.reserve(registry.alive() + 1);
 	uint32_t levelManager = registry.create();
-	auto& levelManagerTag = registry.assign<LevelManagerTag>(entt::tag_t{}, levelManager, &(*levelPack), level);
+	// Fixed seed so that a level looks the same every time it is previewed
+	registry.assign<LevelManagerTag>(entt::tag_t{}, levelManager, &(*levelPack), level, 0);
 
 	// Create the player
 	auto params = levelPack->getPlayer();
@@ -1795,10 +2336,21 @@ void SimpleEngineRenderer::loadLevel(std::shared_ptr<Level> level) {
 
 void SimpleEngineRenderer::pause() {
 	paused = true;
+	keyboardInput.setPaused(true);
 }
 
 void SimpleEngineRenderer::unpause() {
 	paused = false;
+	keyboardInput.setPaused(false);
+}
+
+std::unique_ptr<RegistrySnapshot> SimpleEngineRenderer::takeSnapshot() {
+	return std::make_unique<RegistrySnapshot>(registry, *queue);
+}
+
+void SimpleEngineRenderer::restoreSnapshot(const RegistrySnapshot& snapshot) {
+	snapshot.restore(registry);
+	reserveMemory(registry, std::max(INITIAL_EDITOR_ENTITY_RESERVATION, levelPack->getLevelProfile(registry.get<LevelManagerTag>().getLevel()).expectedPeakEntityCount));
 }
 
 void SimpleEngineRenderer::physicsUpdate(float deltaTime) const {
@@ -1823,7 +2375,7 @@ void SimpleEngineRenderer::physicsUpdate(float deltaTime) const {
 		collectibleSystem->update(deltaTime);
 		queue->executeAll();
 
-		playerSystem->update(deltaTime);
+		playerSystem->update(deltaTime, keyboardInput.poll());
 		queue->executeAll();
 
 		enemySystem->update(deltaTime);
@@ -2470,7 +3022,7 @@ bool MarkerPlacer::handleEvent(sf::Event event) {
 				},
 					[this, newIndex]() {
 					removeMarker(newIndex);
-				}));
+				}, sizeof(newIndex) + sizeof(mouseWorldPos)));
 			} else {
 				int i = 0;
 				for (auto p : markers) {
@@ -2535,7 +3087,7 @@ bool MarkerPlacer::handleEvent(sf::Event event) {
 							markers[selectedMarkerIndex].setPosition(markerPosBeforeDragging);
 							setSelectedMarkerXWidgetValue(markerPosBeforeDragging.x);
 							setSelectedMarkerYWidgetValue(-markerPosBeforeDragging.y);
-					}));
+					}, sizeof(endPos)));
 				}
 			}
 
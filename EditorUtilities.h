@@ -28,12 +28,15 @@
 #include "ViewController.h"
 #include "EventCapturable.h"
 #include "LRUCache.h"
+#include "RegistrySnapshot.h"
 #include "ExtraSignals.h"
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <entt/entt.hpp>
 #include <tuple>
+#include <set>
 
 /*
 Sends window to the foreground of the computer display.
@@ -62,14 +65,11 @@ playerX, playerY - position of the player
 sf::VertexArray generateVertexArray(std::vector<std::shared_ptr<EMPAction>> actions, float timeResolution, float x, float y, float playerX, float playerY, sf::Color startColor = sf::Color::Red, sf::Color endColor = sf::Color::Blue);
 sf::VertexArray generateVertexArray(std::shared_ptr<EMPAction> action, float timeResolution, float x, float y, float playerX, float playerY, sf::Color startColor = sf::Color::Red, sf::Color endColor = sf::Color::Blue);
 /*
-Returns an array of segment data. Each segment data is 2 vectors of floats in order:
-the x-coordinates and the y-coordinates of a matplotlibc curve.
-The x-axis represents time in seconds and the y-axis the TFV's value.
-
-timeResolution - the amount of time between each point
-colors - the list of colors that will be looped to determine the color of each segment of the curve
+Returns how well text matches pattern, ignoring case, or -1 if it doesn't match at all.
+Text matches if every character of pattern appears in it in order, not necessarily consecutively.
+Matches of consecutive characters and at the start of words score higher.
 */
-std::vector<std::pair<std::vector<float>, std::vector<float>>> generateMPLPoints(std::shared_ptr<PiecewiseTFV> tfv, float tfvLifespan, float timeResolution);
+int fuzzyMatchScore(const std::string& pattern, const std::string& text);
 
 class EditorWindow;
 class UndoableEditorWindow;
@@ -374,6 +374,25 @@ private:
 };
 
 
+/*
+Measures the width of text as shown by a Label.
+Measuring is slow, so widths are cached.
+*/
+class TextWidthChecker {
+public:
+	TextWidthChecker();
+
+	float getWidth(const std::string& text);
+	void setTextSize(int textSize);
+
+private:
+	const int CACHE_SIZE = 4096;
+
+	std::shared_ptr<tgui::Label> label;
+	// Maps text to its width at the current text size
+	Cache<std::string, float> cache;
+};
+
 /*
 A ScrollablePanel that can scroll horizontally as well as vertically and contains a ListBox.
 The ListBox from getListBox() does not have to be added to a container, since it is already part of this ScrollablePanel.
@@ -402,8 +421,11 @@ public:
 
 private:
 	std::shared_ptr<tgui::ListBox> listBox;
-	std::shared_ptr<tgui::Label> textWidthChecker;
-	float longestWidth;
+	TextWidthChecker textWidthChecker;
+	// Width of the text of the widest item in the ListBox
+	float largestItemWidth = 0;
+
+	void updateListBoxWidth();
 };
 
 /*
@@ -411,7 +433,9 @@ A ScrollablePanel that can scroll horizontally as well as vertically and contain
 The ListView from getListView() does not have to be added to a container, since it is already part of this ScrollablePanel.
 
 This widget can be treated as a normal ListView, with the exception that onListViewItemsUpdate() should be called
-anytime an item is added, removed, or changed from the ListView.
+anytime an item is added, removed, or changed from the ListView. When only a single item is added, removed, or changed,
+insertItem(), removeItem(), or changeItem() can be used instead, which is much faster when there are many items
+and also works while a filter is set.
 
 The only advantage of a ListBox over a ListView is that items can be identified by a
 unique id string. This can be easily implemented with your own std::map, however.
@@ -427,15 +451,200 @@ public:
 	Should be called anytime an item is added, removed, or has its text changed from the ListView.
 	*/
 	void onListViewItemsUpdate();
+	/*
+	Adds an item so that it has index unfilteredIndex when there is no filter.
+	It is only shown if it matches the filter.
+	*/
+	void insertItem(int unfilteredIndex, const sf::String& item);
+	/*
+	Removes the item at unfilteredIndex when there is no filter.
+	*/
+	void removeItem(int unfilteredIndex);
+	/*
+	Changes the text of the item at unfilteredIndex when there is no filter.
+	The item is shown, hidden, or moved if its match with the filter changes.
+	*/
+	void changeItem(int unfilteredIndex, const sf::String& item);
 	bool mouseWheelScrolled(float delta, tgui::Vector2f pos) override;
 
+	/*
+	Shows only the items whose text fuzzily matches filter, best matches first. See fuzzyMatchScore().
+	An empty filter shows every item again in their original order. Selected items stay selected if they are still shown.
+	While a filter is set, items should only be added, removed, or changed through insertItem(), removeItem(), and changeItem().
+	*/
+	void setFilter(const std::string& filter);
+	/*
+	Returns the index the item shown at index would have if there were no filter.
+	*/
+	int getUnfilteredIndex(int index) const;
+	/*
+	Returns the index the item at unfilteredIndex when there is no filter is shown at, or -1 if it is filtered out.
+	*/
+	int getFilteredIndex(int unfilteredIndex) const;
+
 	void setTextSize(int textSize);
 	inline std::shared_ptr<tgui::ListView> getListView() { return listView; }
 
 private:
 	std::shared_ptr<tgui::ListView> listView;
-	std::shared_ptr<tgui::Label> textWidthChecker;
-	float longestWidth;
+	TextWidthChecker textWidthChecker;
+	// Widths of the text of every item in the ListView
+	std::multiset<float> itemWidths;
+
+	std::string filter;
+	// The following are only used while filter is not empty
+	// The text of every item in their original order
+	std::vector<sf::String> unfilteredItems;
+	// The index in listView of every item in unfilteredItems, or -1 if it is not shown
+	std::vector<int> filteredIndices;
+	// The index in unfilteredItems of every item shown
+	std::vector<int> unfilteredIndices;
+	// The fuzzyMatchScore() of every item shown, which is never increasing
+	std::vector<int> shownScores;
+
+	/*
+	Adds an item to listView at index, moving the items at and after index down by one.
+	*/
+	void insertShownItem(int index, const sf::String& item);
+	/*
+	Changes the text of the item shown at index.
+	*/
+	void changeShownItem(int index, const sf::String& item);
+	void updateListViewWidth();
+};
+
+/*
+A graph of a PiecewiseTFV's value over its lifespan, drawn in the editor, with alternating colors for each segment.
+
+The TFV is sampled on a worker thread so that the editor never waits for it. The first pass is coarse and every pass
+after it halves the time between samples; the graph shows the latest finished pass. Times right around the start
+of each segment are always sampled densely so that jumps between segments are sharp from the first pass.
+Finished graphs are cached by the TFV's formatted string and lifespan.
+*/
+class TFVGraph : public tgui::Panel {
+public:
+	TFVGraph();
+	~TFVGraph();
+	inline static std::shared_ptr<TFVGraph> create() {
+		return std::make_shared<TFVGraph>();
+	}
+
+	/*
+	Starts graphing a TFV and cancels the graphing of the previous one, if it isn't done yet.
+	tfv is copied, so it can be modified right after this call.
+	*/
+	void setTFV(std::shared_ptr<PiecewiseTFV> tfv, float tfvLifespan);
+
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+	struct GraphPoints {
+		// Each segment is a pair of the times and the TFV's values at those times
+		std::vector<std::pair<std::vector<float>, std::vector<float>>> segments;
+		float lowestValue;
+		float highestValue;
+		float lifespan;
+	};
+
+	// Samples in the first pass, not including the ones around segment boundaries
+	const int FIRST_PASS_SAMPLES = 32;
+	// Sampling stops after the pass with this many samples or with this much time between samples
+	const int MAX_SAMPLES = 4096;
+	const float FINEST_TIME_RESOLUTION = 0.005f;
+	// Samples on each side of a segment boundary, within one time resolution of it
+	const int BOUNDARY_SAMPLES = 4;
+	// Time before a segment's start time at which the previous segment is sampled
+	const float BOUNDARY_EPSILON = 0.0001f;
+	// The worker checks if it was cancelled after evaluating this many samples
+	const int CANCEL_CHECK_INTERVAL = 256;
+
+	// Guards points and cache, which are written by the worker
+	mutable std::mutex pointsMutex;
+	// Points of the latest finished pass; nullptr if nothing has been graphed yet
+	std::shared_ptr<GraphPoints> points;
+	Cache<std::string, std::shared_ptr<GraphPoints>> cache;
+
+	std::thread worker;
+	// Set to cancel the worker's current job
+	std::shared_ptr<std::atomic<bool>> cancelled;
+	// Cache key of the TFV that is being or was last graphed
+	std::string currentCacheKey;
+
+	/*
+	Cancels the worker's current job, if any, and waits for it to stop.
+	*/
+	void cancel();
+	/*
+	Run on the worker thread.
+	*/
+	void sample(std::shared_ptr<PiecewiseTFV> tfv, float tfvLifespan, std::string cacheKey, std::shared_ptr<std::atomic<bool>> cancelled);
+};
+
+/*
+The path taken by something following a list of EMPActions, drawn in the editor and fit to the widget's size.
+The path goes from red at the start to blue at the end.
+
+Sampled on a worker thread the same way as TFVGraph: each pass halves the time between samples, and the start and
+end of every action are always sampled. Finished paths are cached by the actions' formatted strings and the
+start and player positions.
+*/
+class EMPPathGraph : public tgui::Panel {
+public:
+	EMPPathGraph();
+	~EMPPathGraph();
+	inline static std::shared_ptr<EMPPathGraph> create() {
+		return std::make_shared<EMPPathGraph>();
+	}
+
+	/*
+	Starts graphing a path and cancels the graphing of the previous one, if it isn't done yet.
+	The actions are copied, so they can be modified right after this call.
+
+	x, y - the position the path starts at
+	playerX, playerY - the position of the player, for actions that depend on it
+	*/
+	void setPath(std::vector<std::shared_ptr<EMPAction>> actions, float x, float y, float playerX, float playerY);
+
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+	struct PathPoints {
+		// Positions along the path, in order
+		std::vector<sf::Vector2f> positions;
+		// Time at each position since the start of the path
+		std::vector<float> times;
+		float totalTime;
+		sf::FloatRect bounds;
+	};
+
+	// Samples in the first pass, not including the ones at the start and end of each action
+	const int FIRST_PASS_SAMPLES = 32;
+	// Sampling stops after the pass with this many samples or with this much time between samples
+	const int MAX_SAMPLES = 4096;
+	const float FINEST_TIME_RESOLUTION = 0.005f;
+	// The worker checks if it was cancelled after evaluating this many samples
+	const int CANCEL_CHECK_INTERVAL = 256;
+
+	// Guards points and cache, which are written by the worker
+	mutable std::mutex pointsMutex;
+	// Points of the latest finished pass; nullptr if nothing has been graphed yet
+	std::shared_ptr<PathPoints> points;
+	Cache<std::string, std::shared_ptr<PathPoints>> cache;
+
+	std::thread worker;
+	// Set to cancel the worker's current job
+	std::shared_ptr<std::atomic<bool>> cancelled;
+	// Cache key of the path that is being or was last graphed
+	std::string currentCacheKey;
+
+	/*
+	Cancels the worker's current job, if any, and waits for it to stop.
+	*/
+	void cancel();
+	/*
+	Run on the worker thread.
+	*/
+	void sample(std::vector<std::shared_ptr<EMPAction>> actions, float x, float y, float playerX, float playerY, std::string cacheKey, std::shared_ptr<std::atomic<bool>> cancelled);
 };
 
 /*
@@ -466,12 +675,13 @@ public:
 	tgui::Signal& getSignal(std::string signalName) override;
 
 private:
-	const float TFV_TIME_RESOLUTION = 0.05f; // Time between each tfv curve vertex
+	const float TFV_GRAPH_HEIGHT = 150;
 
 	EditorWindow& parentWindow;
 	std::recursive_mutex tfvMutex;
 
 	std::shared_ptr<tgui::Button> showGraph;
+	std::shared_ptr<TFVGraph> graph;
 
 	std::shared_ptr<tgui::Button> addSegment;
 	std::shared_ptr<tgui::Button> deleteSegment;
@@ -512,6 +722,10 @@ private:
 	void deselectSegment();
 	void selectSegment(int index);
 	void populateSegmentList();
+	/*
+	Regraphs the TFV if the graph is visible.
+	*/
+	void updateGraph();
 };
 
 /*
@@ -591,6 +805,16 @@ public:
 	void pause();
 	void unpause();
 
+	/*
+	Takes a snapshot of every entity in the current level.
+	*/
+	std::unique_ptr<RegistrySnapshot> takeSnapshot();
+	/*
+	Returns the current level to the state it was in when the snapshot was taken.
+	The snapshot must have been taken by this renderer while in the same level.
+	*/
+	void restoreSnapshot(const RegistrySnapshot& snapshot);
+
 protected:
 	std::shared_ptr<LevelPack> levelPack;
 	mutable entt::DefaultRegistry registry;
@@ -603,6 +827,8 @@ protected:
 	std::unique_ptr<SpriteAnimationSystem> spriteAnimationSystem;
 	std::unique_ptr<ShadowTrailSystem> shadowTrailSystem;
 	std::unique_ptr<PlayerSystem> playerSystem;
+	// Polled from the const physics update
+	mutable KeyboardInputSource keyboardInput;
 	std::unique_ptr<CollectibleSystem> collectibleSystem;
 	std::unique_ptr<AudioPlayer> audioPlayer;
 
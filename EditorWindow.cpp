@@ -359,6 +359,27 @@ void EditorWindow::closeConfirmationPanel() {
 	}
 }
 
+UndoableEditorWindow::UndoableEditorWindow(std::shared_ptr<std::recursive_mutex> tguiMutex, std::string windowTitle, int width, int height, UndoStack& undoStack, bool scaleWidgetsOnResize, bool letterboxingEnabled, float renderInterval) :
+	EditorWindow(tguiMutex, windowTitle, width, height, scaleWidgetsOnResize, letterboxingEnabled, renderInterval), undoStack(undoStack) {
+	std::lock_guard<std::recursive_mutex> lock(*tguiMutex);
+	undoStackMemoryUsageLabel = tgui::Label::create();
+	undoStackMemoryUsageLabel->setTextSize(TEXT_SIZE);
+	undoStackMemoryUsageLabel->ignoreMouseEvents(true);
+	undoStackMemoryUsageLabel->setPosition(tgui::bindWidth(*gui) - tgui::bindWidth(undoStackMemoryUsageLabel), tgui::bindHeight(*gui) - tgui::bindHeight(undoStackMemoryUsageLabel));
+	gui->add(undoStackMemoryUsageLabel);
+}
+
+void UndoableEditorWindow::render(float deltaTime) {
+	size_t memoryUsage = undoStack.getMemoryUsage();
+	if (memoryUsage != shownUndoStackMemoryUsage) {
+		std::lock_guard<std::recursive_mutex> lock(*tguiMutex);
+		// Rounded up so that a nonempty undo stack never shows 0
+		undoStackMemoryUsageLabel->setText("Undo history: " + std::to_string((memoryUsage + 1023) / 1024) + " KB");
+		shownUndoStackMemoryUsage = memoryUsage;
+	}
+	EditorWindow::render(deltaTime);
+}
+
 void UndoableEditorWindow::handleEvent(sf::Event event) {
 	EditorWindow::handleEvent(event);
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl) || sf::Keyboard::isKeyPressed(sf::Keyboard::RControl)) {
@@ -1939,8 +1960,7 @@ MainEditorWindow::MainEditorWindow(std::shared_ptr<std::recursive_mutex> tguiMut
 			attacksAddButton->setPosition(0, 0);
 			attacksAddButton->setSize(SMALL_BUTTON_SIZE, SMALL_BUTTON_SIZE);
 			attacksAddButton->connect("Pressed", [&]() {
-				
-				reloadLeftPanelAttackList();
+				reloadLeftPanelAttack(levelPack->createAttack()->getID());
 			});
 			attacksListViewPanel->add(attacksAddButton);
 
@@ -1951,6 +1971,16 @@ MainEditorWindow::MainEditorWindow(std::shared_ptr<std::recursive_mutex> tguiMut
 			attacksSaveAllButton->setSize(SMALL_BUTTON_SIZE, SMALL_BUTTON_SIZE);
 			attacksListViewPanel->add(attacksSaveAllButton);
 
+			// Filter
+			attacksFilter = tgui::EditBox::create();
+			attacksFilter->setDefaultText("Search");
+			attacksFilter->setPosition(tgui::bindRight(attacksSaveAllButton), 0);
+			attacksFilter->setSize(tgui::bindWidth(attacksListViewPanel) - tgui::bindRight(attacksSaveAllButton), SMALL_BUTTON_SIZE);
+			attacksFilter->connect("TextChanged", [&]() {
+				attacksListView->setFilter(attacksFilter->getText());
+			});
+			attacksListViewPanel->add(attacksFilter);
+
 			// List view
 			attacksListView = ListViewScrollablePanel::create();
 			attacksListView->getListView()->setMultiSelect(true);
@@ -2021,7 +2051,7 @@ MainEditorWindow::MainEditorWindow(std::shared_ptr<std::recursive_mutex> tguiMut
 				});
 			}
 			attacksListView->getListView()->connect("DoubleClicked", [&](int index) {
-				openLeftPanelAttack(attacksListViewIndexToAttackIDMap[index]);
+				openLeftPanelAttack(attacksListViewAttackIDs[attacksListView->getUnfilteredIndex(index)]);
 			});
 			attacksListViewPanel->add(attacksListView);
 		}
@@ -2056,24 +2086,46 @@ void MainEditorWindow::handleEvent(sf::Event event) {
 }
 
 void MainEditorWindow::reloadLeftPanelAttackList() {
-	attackIDToAttacksListViewIndexMap.clear();
-	attacksListViewIndexToAttackIDMap.clear();
+	// The items can't be modified while filtered, so the filter is applied again afterwards
+	attacksListView->setFilter("");
+
+	attacksListViewAttackIDs.clear();
 	attacksListView->getListView()->removeAllItems();
 
-	int i = 0;
 	for (auto it = levelPack->getAttackIteratorBegin(); it != levelPack->getAttackIteratorEnd(); it++) {
-		// If the attack is in unsavedAttacks, signify it is unsaved with an asterisk
-		if (unsavedAttacks.count(it->first) > 0) {
-			attacksListView->getListView()->addItem("*[" + std::to_string(it->second->getID()) + "] " + unsavedAttacks[it->first]->getName());
-		} else {
-			attacksListView->getListView()->addItem("[" + std::to_string(it->second->getID()) + "] " + it->second->getName());
-		}
-		attackIDToAttacksListViewIndexMap[it->second->getID()] = i;
-		attacksListViewIndexToAttackIDMap[i] = it->second->getID();
-		i++;
+		attacksListView->getListView()->addItem(getLeftPanelAttackItemText(it->first));
+		attacksListViewAttackIDs.push_back(it->first);
 	}
 
 	attacksListView->onListViewItemsUpdate();
+	attacksListView->setFilter(attacksFilter->getText());
+}
+
+void MainEditorWindow::reloadLeftPanelAttack(int attackID) {
+	auto it = std::lower_bound(attacksListViewAttackIDs.begin(), attacksListViewAttackIDs.end(), attackID);
+	int index = it - attacksListViewAttackIDs.begin();
+	bool inList = (it != attacksListViewAttackIDs.end() && *it == attackID);
+
+	if (!levelPack->hasAttack(attackID)) {
+		if (inList) {
+			attacksListViewAttackIDs.erase(it);
+			attacksListView->removeItem(index);
+		}
+	} else if (inList) {
+		attacksListView->changeItem(index, getLeftPanelAttackItemText(attackID));
+	} else {
+		attacksListViewAttackIDs.insert(it, attackID);
+		attacksListView->insertItem(index, getLeftPanelAttackItemText(attackID));
+	}
+}
+
+std::string MainEditorWindow::getLeftPanelAttackItemText(int attackID) {
+	// If the attack is in unsavedAttacks, signify it is unsaved with an asterisk
+	if (unsavedAttacks.count(attackID) > 0) {
+		return "*[" + std::to_string(attackID) + "] " + unsavedAttacks[attackID]->getName();
+	} else {
+		return "[" + std::to_string(attackID) + "] " + levelPack->getAttack(attackID)->getName();
+	}
 }
 
 void MainEditorWindow::openLeftPanelAttack(int attackID) {
@@ -2081,8 +2133,14 @@ void MainEditorWindow::openLeftPanelAttack(int attackID) {
 	if (leftPanel->getSelectedTab() != LEFT_PANEL_ATTACK_LIST_TAB_NAME) {
 		leftPanel->selectTab(LEFT_PANEL_ATTACK_LIST_TAB_NAME);
 	}
-	// Select the attack in attacksListView
-	attacksListView->getListView()->setSelectedItem(attackIDToAttacksListViewIndexMap[attackID]);
+	// Select the attack in attacksListView, if it isn't filtered out
+	auto it = std::lower_bound(attacksListViewAttackIDs.begin(), attacksListViewAttackIDs.end(), attackID);
+	if (it != attacksListViewAttackIDs.end() && *it == attackID) {
+		int index = attacksListView->getFilteredIndex(it - attacksListViewAttackIDs.begin());
+		if (index >= 0) {
+			attacksListView->getListView()->setSelectedItem(index);
+		}
+	}
 
 	// Get the attack
 	std::shared_ptr<EditorAttack> openedAttack;
@@ -2107,7 +2165,7 @@ void MainEditorWindow::openLeftPanelAttack(int attackID) {
 		});
 		attackEditorPanel->connect("AttackModified", [&](std::shared_ptr<EditorAttack> attack) {
 			unsavedAttacks[attack->getID()] = attack;
-			reloadLeftPanelAttackList();
+			reloadLeftPanelAttack(attack->getID());
 		});
 		mainPanel->addTab(format(MAIN_PANEL_ATTACK_TAB_NAME_FORMAT, attackID), attackEditorPanel, true, true);
 	}
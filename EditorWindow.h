@@ -115,6 +115,10 @@ public:
 protected:
 	std::shared_ptr<sf::RenderWindow> window;
 	std::shared_ptr<tgui::Gui> gui;
+	// Mutex used to make sure multiple tgui widgets aren't being instantiated at the same time in different threads.
+	// tgui::Gui draw() calls also can't be done at the same time.
+	// Apparently tgui gets super messed up with multithreading.
+	std::shared_ptr<std::recursive_mutex> tguiMutex;
 
 	// The last known position of the mouse
 	sf::Vector2f mousePos = sf::Vector2f(0, 0);
@@ -160,11 +164,6 @@ private:
 	bool letterboxingEnabled;
 	bool scaleWidgetsOnResize;
 
-	// Mutex used to make sure multiple tgui widgets aren't being instantiated at the same time in different threads.
-	// tgui::Gui draw() calls also can't be done at the same time.
-	// Apparently tgui gets super messed up with multithreading.
-	std::shared_ptr<std::recursive_mutex> tguiMutex;
-	
 	float renderInterval;
 	// Signal that's emitted every time a render call is made
 	// function accepts 1 argument: the time since the last render
@@ -186,18 +185,22 @@ private:
 An EditorWindow that has the capability of redoing and undoing commands in the UndoStack.
 Undo is done with control+z and redo with control+y.
 Commands must be added to the UndoStack by the user.
+The memory used by the UndoStack is shown in the bottom right corner.
 */
 class UndoableEditorWindow : public EditorWindow {
 public:
-	inline UndoableEditorWindow(std::shared_ptr<std::recursive_mutex> tguiMutex, std::string windowTitle, int width, int height, UndoStack& undoStack, bool scaleWidgetsOnResize = false, bool letterboxingEnabled = false, float renderInterval = RENDER_INTERVAL) :
-		EditorWindow(tguiMutex, windowTitle, width, height, scaleWidgetsOnResize, letterboxingEnabled, renderInterval), undoStack(undoStack) {
-	}
+	UndoableEditorWindow(std::shared_ptr<std::recursive_mutex> tguiMutex, std::string windowTitle, int width, int height, UndoStack& undoStack, bool scaleWidgetsOnResize = false, bool letterboxingEnabled = false, float renderInterval = RENDER_INTERVAL);
 
 protected:
 	virtual void handleEvent(sf::Event event);
+	virtual void render(float deltaTime);
 
 private:
 	UndoStack& undoStack;
+
+	std::shared_ptr<tgui::Label> undoStackMemoryUsageLabel;
+	// The memory usage currently shown by undoStackMemoryUsageLabel
+	size_t shownUndoStackMemoryUsage = -1;
 };
 //
 //class GameplayTestWindow : public UndoableEditorWindow {
@@ -600,13 +603,12 @@ private:
 
 	// -------------------- Part of leftPanel --------------------
 	std::shared_ptr<tgui::Panel> attacksListViewPanel;
+	std::shared_ptr<tgui::EditBox> attacksFilter;
 	std::shared_ptr<ListViewScrollablePanel> attacksListView;
 	
 	// -------------------- Part of mainPanel --------------------
-	// Maps an EditorAttack ID to its index in attacksListView
-	std::map<int, int> attackIDToAttacksListViewIndexMap;
-	// Maps an index in attacksListView to the associated EditorAtack ID
-	std::map<int, int> attacksListViewIndexToAttackIDMap;
+	// The ID of the EditorAttack at every index in attacksListView when unfiltered, in ascending order
+	std::vector<int> attacksListViewAttackIDs;
 	// Maps an EditorAttack ID to the EditorAttack object that has unsaved changes.
 	// If the ID doesn't exist in this map, then there are no unsaved changes
 	// for that ID.
@@ -615,8 +617,18 @@ private:
 
 	/*
 	Repopulate the attack list in the left panel.
+	The text of attacksFilter is applied again afterwards; see ListViewScrollablePanel::setFilter().
 	*/
 	void reloadLeftPanelAttackList();
+	/*
+	Update a single attack's item in the attack list in the left panel, adding it if it was just created
+	or removing it if it was just deleted, without repopulating the rest of the list.
+	*/
+	void reloadLeftPanelAttack(int attackID);
+	/*
+	Returns the text of an attack's item in the attack list in the left panel.
+	*/
+	std::string getLeftPanelAttackItemText(int attackID);
 
 	/*
 	Open a single attack in the left panel's attack list so that
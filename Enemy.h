@@ -30,6 +30,7 @@ public:
 
 	inline int getID() const { return id; }
 	inline std::tuple<std::shared_ptr<EnemyPhaseStartCondition>, int, EntityAnimatableSet> getPhaseData(int index) const { return phaseIDs[index]; }
+	inline const std::shared_ptr<EnemyPhaseStartCondition>& getPhaseStartCondition(int index) const { return std::get<0>(phaseIDs[index]); }
 	inline int getPhasesCount() const { return phaseIDs.size(); }
 	inline std::string getName() const { return name; }
 	inline float getHitboxRadius() const { return hitboxRadius; }
@@ -42,6 +43,8 @@ public:
 	// Returns a reference
 	inline SoundSettings& getDeathSound() { return deathSound; }
 	inline bool usesEnemyPhase(int enemyPhaseID) const { return enemyPhaseCount.count(enemyPhaseID) > 0 && enemyPhaseCount.at(enemyPhaseID) > 0; }
+	// Returns a map of the IDs of every EditorEnemyPhase this enemy uses to the number of times it is used
+	inline const std::map<int, int>& getEnemyPhaseIDCount() const { return enemyPhaseCount; }
 
 	inline void addDeathAction(std::shared_ptr<DeathAction> action) { deathActions.push_back(action); }
 	inline void removeDeathAction(int index) { deathActions.erase(deathActions.begin() + index); }
@@ -47,6 +47,8 @@ public:
 	*/
 	inline MusicSettings& getMusicSettings() { return musicSettings; }
 	inline bool usesAttackPattern(int attackPatternID) { return attackPatternIDCount.count(attackPatternID) > 0 && attackPatternIDCount.at(attackPatternID) > 0; }
+	// Returns a map of the IDs of every EditorAttackPattern this enemy phase uses to the number of times it is used
+	inline const std::map<int, int>& getAttackPatternIDCount() const { return attackPatternIDCount; }
 
 	/*
 	Add an EditorAttackPattern to this enemy phase.
@@ -38,7 +38,7 @@ void EnemyCountBasedEnemyPhaseStartCondition::load(std::string formattedString)
 }
 
 bool EnemyCountBasedEnemyPhaseStartCondition::satisfied(entt::DefaultRegistry & registry, uint32_t entity) {
-	return registry.view<EnemyComponent>().size() - 1 <= enemyCount;
+	return registry.get<LevelManagerTag>().getEnemiesAlive() - 1 <= enemyCount;
 }
 
 std::shared_ptr<EnemyPhaseStartCondition> EnemyPhaseStartConditionFactory::create(std::string formattedString) {
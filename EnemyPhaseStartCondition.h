@@ -16,6 +16,12 @@ public:
 	void load(std::string formattedString) = 0;
 
 	virtual bool satisfied(entt::DefaultRegistry& registry, uint32_t entity) = 0;
+	/*
+	Returns the time since the start of the enemy's last phase at which this condition will be satisfied,
+	or a negative number if this condition does not depend on time. Conditions that do not depend on time
+	only need to be checked with satisfied() when the enemy's health or the number of enemies alive changes.
+	*/
+	inline virtual float getSatisfiedTime() const { return -1; }
 };
 
 /*
@@ -30,6 +36,7 @@ public:
 	void load(std::string formattedString) override;
 
 	bool satisfied(entt::DefaultRegistry& registry, uint32_t entity) override;
+	inline float getSatisfiedTime() const override { return time; }
 
 	inline float getTime() { return time; }
 
@@ -3,7 +3,18 @@
 void EnemySystem::update(float deltaTime) {
 	auto view = registry.view<EnemyComponent>();
 
+	// Enemy count based phase start conditions only need to be checked when the enemy count changes
+	bool enemyCountChanged = false;
+	if (registry.has<LevelManagerTag>()) {
+		int enemiesAlive = registry.get<LevelManagerTag>().getEnemiesAlive();
+		enemyCountChanged = enemiesAlive != lastEnemiesAlive;
+		lastEnemiesAlive = enemiesAlive;
+	}
+
 	view.each([&](auto entity, auto& enemy) {
+		if (enemyCountChanged) {
+			enemy.onEnemyCountChange();
+		}
 		enemy.update(queue, spriteLoader, levelPack, registry, entity, deltaTime);
 	});
 }
\ No newline at end of file
@@ -18,4 +18,7 @@ private:
 	const LevelPack& levelPack;
 	entt::DefaultRegistry& registry;
 	SpriteLoader& spriteLoader;
+
+	// Number of enemies alive as of the last update
+	int lastEnemiesAlive = 0;
 };
\ No newline at end of file
@@ -10,7 +10,6 @@
 #include <iostream>
 #include "MovablePoint.h"
 #include "LevelPack.h"
-#include <random>
 
 EMPSpawnFromEnemyCommand::EMPSpawnFromEnemyCommand(entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, std::shared_ptr<EditorMovablePoint> emp, bool isMainEMP, uint32_t entity, float timeLag, int attackID, int attackPatternID, int enemyID, int enemyPhaseID, bool playAttackAnimation) :
 	EntityCreationCommand(registry), spriteLoader(spriteLoader), emp(emp), isMainEMP(isMainEMP), playAttackAnimation(playAttackAnimation),
@@ -395,10 +394,7 @@ EMPDropItemCommand::EMPDropItemCommand(entt::DefaultRegistry & registry, SpriteL
 }
 
 void EMPDropItemCommand::execute(EntityCreationQueue & queue) {
-	std::mt19937 eng;
-	std::uniform_real_distribution<float> explosionTimeDistribution(1.0f, 2.0f);
-	std::uniform_real_distribution<float> explosionDistanceDistribution(150.0f, 250.0f);
-	std::uniform_real_distribution<float> explosionAngleDistribution(70.0f * PI/180.0f, 110.0f * PI/180.0f);
+	RandomStream random = registry.get<LevelManagerTag>().createRandomStream();
 
 	float spriteSublayer = registry.get<LevelManagerTag>().getTimeSinceStartOfLevel();
 
@@ -413,9 +409,9 @@ void EMPDropItemCommand::execute(EntityCreationQueue & queue) {
 		// Movement path mimics an explosion upwards (70-110 degrees) and then dropping down
 		std::vector<std::shared_ptr<EMPAction>> actions;
 		// Explosion
-		float explosionTime = explosionTimeDistribution(eng);
-		std::shared_ptr<TFV> explosionDistance = std::make_shared<DampenedEndTFV>(0, explosionDistanceDistribution(eng), explosionTime, 10);
-		std::shared_ptr<TFV> explosionAngle = std::make_shared<ConstantTFV>(explosionAngleDistribution(eng));
+		float explosionTime = random.nextFloat(1.0f, 2.0f);
+		std::shared_ptr<TFV> explosionDistance = std::make_shared<DampenedEndTFV>(0, random.nextFloat(150.0f, 250.0f), explosionTime, 10);
+		std::shared_ptr<TFV> explosionAngle = std::make_shared<ConstantTFV>(random.nextFloat(70.0f * PI/180.0f, 110.0f * PI/180.0f));
 		actions.push_back(std::make_shared<MoveCustomPolarEMPA>(explosionDistance, explosionAngle, explosionTime));
 		// Drop down
 		std::shared_ptr<TFV> dropDistance = std::make_shared<DampenedStartTFV>(0, MAP_HEIGHT + 250 + sprite.getSprite()->getOrigin().y, ITEM_DESPAWN_TIME - explosionTime, 10);
@@ -436,16 +432,13 @@ ParticleExplosionCommand::ParticleExplosionCommand(entt::DefaultRegistry & regis
 }
 
 void ParticleExplosionCommand::execute(EntityCreationQueue & queue) {
-	std::mt19937 eng;
-	std::uniform_int_distribution<int> particlesCount(minParticles, maxParticles);
-	std::uniform_real_distribution<float> lifespan(minLifespan, maxLifespan);
-	std::uniform_real_distribution<float> distance(minDistance, maxDistance);
-	std::uniform_real_distribution<float> angle(0.0f, PI2);
+	RandomStream random = registry.get<LevelManagerTag>().createRandomStream();
 
 	float spriteSublayer = registry.get<LevelManagerTag>().getTimeSinceStartOfLevel();
 
-	for (int i = 0; i < particlesCount(eng); i++) {
-		float particleLifespan = lifespan(eng);
+	int particlesCount = random.nextInt(minParticles, maxParticles);
+	for (int i = 0; i < particlesCount; i++) {
+		float particleLifespan = random.nextFloat(minLifespan, maxLifespan);
 
 		uint32_t particle = registry.create();
 		registry.assign<DespawnComponent>(particle, particleLifespan);
@@ -454,7 +447,7 @@ void ParticleExplosionCommand::execute(EntityCreationQueue & queue) {
 		// Overwrite sprite sheet entry's color
 		sprite.getSprite()->setColor(color);
 
-		std::vector<std::shared_ptr<EMPAction>> path = { std::make_shared<MoveCustomPolarEMPA>(std::make_shared<LinearTFV>(0, distance(eng), particleLifespan), std::make_shared<ConstantTFV>(angle(eng)), particleLifespan) };
+		std::vector<std::shared_ptr<EMPAction>> path = { std::make_shared<MoveCustomPolarEMPA>(std::make_shared<LinearTFV>(0, random.nextFloat(minDistance, maxDistance), particleLifespan), std::make_shared<ConstantTFV>(random.nextFloat(0.0f, PI2)), particleLifespan) };
 		registry.assign<MovementPathComponent>(particle, queue, particle, registry, particle, std::make_shared<SpecificGlobalEMPSpawn>(0, sourceX, sourceY), path, 0);
 
 		if (effect == ParticleExplosionDeathAction::NONE) {
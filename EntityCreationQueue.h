@@ -333,6 +333,9 @@ public:
 			command->execute(*this);
 		}
 	}
+	inline bool isEmpty() const {
+		return queue.empty();
+	}
 
 private:
 	entt::DefaultRegistry& registry;
@@ -4,7 +4,9 @@
 #include <fstream>
 #include <vector>
 #include <algorithm>
+#include <random>
 #include <boost/format.hpp>
+#include <boost/log/trivial.hpp>
 #include "SpriteLoader.h"
 #include "TextFileParser.h"
 #include "Components.h"
@@ -167,18 +169,20 @@ GameInstance::GameInstance(std::string levelPackName) {
 	queue = std::make_unique<EntityCreationQueue>(registry);
 
 	spriteLoader = levelPack->createSpriteLoader();
+	// Texture uploads must happen on this thread since it owns the window's context
 	spriteLoader->preloadTextures();
+	BOOST_LOG_TRIVIAL(info) << "Level pack load times:\n" << levelPack->getLoadTimeReport().toString() << "Sprite loader load times:\n" << spriteLoader->getLoadTimeReport().toString();
 
 	movementSystem = std::make_unique<MovementSystem>(*queue, *spriteLoader, registry);
 	//TODO: these numbers should come from settings
-	renderSystem = std::make_unique<RenderSystem>(registry, *window, *spriteLoader, 1.0f);
+	renderSystem = std::make_unique<RenderSystem>(registry, *window, 1.0f);
 	collisionSystem = std::make_unique<CollisionSystem>(*levelPack, *queue, *spriteLoader, registry, MAP_WIDTH, MAP_HEIGHT);
 	despawnSystem = std::make_unique<DespawnSystem>(registry);
 	enemySystem = std::make_unique<EnemySystem>(*queue, *spriteLoader, *levelPack, registry);
 	spriteAnimationSystem = std::make_unique<SpriteAnimationSystem>(*spriteLoader, registry);
 	shadowTrailSystem = std::make_unique<ShadowTrailSystem>(*queue, registry);
 	playerSystem = std::make_unique<PlayerSystem>(*levelPack, *queue, *spriteLoader, registry);
-	collectibleSystem = std::make_unique<CollectibleSystem>(*queue, registry, *levelPack, MAP_WIDTH, MAP_HEIGHT);
+	collectibleSystem = std::make_unique<CollectibleSystem>(*queue, registry, MAP_WIDTH, MAP_HEIGHT);
 
 	// GUI stuff
 
@@ -296,10 +300,15 @@ void GameInstance::start() {
 				break;
 			}
 
-			float dt = std::min(MAX_PHYSICS_DELTA_TIME, deltaClock.restart().asSeconds());
-			//float dt = 1 / 120.0f;
+			float dt;
+			InputFrame input;
+			if (!nextPhysicsUpdate(deltaClock, dt, input)) {
+				// Replay is over
+				pause();
+				break;
+			}
 			//std::cout << registry.alive() << std::endl;
-			physicsUpdate(dt);
+			physicsUpdate(dt, input);
 
 			timeSinceLastRender += dt;
 		}
@@ -314,7 +323,28 @@ void GameInstance::close() {
 	gameInstanceCloseQueued = true;
 }
 
-void GameInstance::physicsUpdate(float deltaTime) {
+bool GameInstance::nextPhysicsUpdate(sf::Clock& clock, float& deltaTime, InputFrame& input) {
+	if (playback) {
+		if (playbackFrameIndex >= playback->getFramesCount()) {
+			return false;
+		}
+		auto frame = playback->getFrame(playbackFrameIndex++);
+		deltaTime = frame.first;
+		input = frame.second;
+		// Keep the clock running so that real time doesn't pile up if the replay stops
+		clock.restart();
+	} else {
+		deltaTime = std::min(MAX_PHYSICS_DELTA_TIME, clock.restart().asSeconds());
+		input = keyboardInput.poll();
+	}
+
+	if (recording) {
+		recordedReplay.addFrame(deltaTime, input);
+	}
+	return true;
+}
+
+void GameInstance::physicsUpdate(float deltaTime, InputFrame input) {
 	if (!paused) {
 		audioPlayer->update(deltaTime);
 
@@ -336,7 +366,7 @@ void GameInstance::physicsUpdate(float deltaTime) {
 		collectibleSystem->update(deltaTime);
 		queue->executeAll();
 
-		playerSystem->update(deltaTime);
+		playerSystem->update(deltaTime, input);
 		queue->executeAll();
 
 		enemySystem->update(deltaTime);
@@ -345,10 +375,31 @@ void GameInstance::physicsUpdate(float deltaTime) {
 }
 
 void GameInstance::render(float deltaTime) {
-	if (!paused) {
-		spriteAnimationSystem->update(deltaTime);
+	if (pipelinedRendering) {
+		// The last frame is drawn before sprite animations are updated, since the shader uniforms
+		// they set have to match the snapshot its batches were built from
+		if (renderPrepTask.valid()) {
+			renderPrepTask.get();
+			renderSystem->draw(renderBatches, deltaTime);
+			// The batches may hold the last reference to a sprite's shader, which must be destroyed on this thread
+			renderBatches.clear();
+		}
+
+		if (!paused) {
+			spriteAnimationSystem->update(deltaTime);
+		}
+
+		// The snapshot is taken here, on the thread that owns the registry; only the snapshot is read from the other thread
+		renderSystem->takeSnapshot(renderSnapshot);
+		renderPrepTask = std::async(std::launch::async, [this]() {
+			renderBatches.build(renderSnapshot);
+		});
+	} else {
+		if (!paused) {
+			spriteAnimationSystem->update(deltaTime);
+		}
+		renderSystem->update(deltaTime);
 	}
-	renderSystem->update(deltaTime);
 
 	// Update bomb opacity depending on time left until cooldown is over
 	auto& playerTag = registry.get<PlayerTag>();
@@ -380,23 +431,40 @@ void GameInstance::render(float deltaTime) {
 }
 
 void GameInstance::loadLevel(int levelIndex) {
+	discardRenderPrep();
+
 	std::shared_ptr<Level> level = levelPack->getLevel(levelIndex);
 
+	// Constructs every level pack object the level can use now rather than in the middle of the level
+	const LevelProfile& levelProfile = levelPack->getLevelProfile(level);
+	collisionSystem->loadLevelProfile(levelProfile);
+	collectibleSystem->loadLevelProfile(levelProfile);
+	for (std::string soundFileName : levelProfile.soundFileNames) {
+		levelPack->preloadSound(soundFileName);
+	}
+
 	// Load bloom settings
 	renderSystem->loadLevelRenderSettings(level);
 
+	movementSystem->setCullingMargin(level->getCullingMargin());
+
 	// Update relevant gui elements
 	levelNameLabel->setText(level->getName());
 
 	// Remove all existing entities from the registry
 	registry.reset();
-	reserveMemory(registry, INITIAL_ENTITY_RESERVATION);
+	reserveMemory(registry, std::max(INITIAL_ENTITY_RESERVATION, levelProfile.expectedPeakEntityCount));
 
 	// Create the level manager
 	registry.reserve<LevelManagerTag>(1);
 	registry.reserve(registry.alive() + 1);
 	uint32_t levelManager = registry.create();
-	auto& levelManagerTag = registry.assign<LevelManagerTag>(entt::tag_t{}, levelManager, &(*levelPack), level);
+	// Replays must use the seed they were recorded with so that randomized spawns play out the same way
+	uint64_t randomSeed = playback ? playback->getRandomSeed() : std::random_device()();
+	if (recording) {
+		recordedReplay.setRandomSeed(randomSeed);
+	}
+	auto& levelManagerTag = registry.assign<LevelManagerTag>(entt::tag_t{}, levelManager, &(*levelPack), level, randomSeed);
 
 	// Create the player
 	createPlayer(*levelPack->getPlayer());
@@ -435,17 +503,80 @@ void GameInstance::endLevel() {
 	points += registry.get<LevelManagerTag>().getPoints();
 }
 
+void GameInstance::discardRenderPrep() {
+	if (renderPrepTask.valid()) {
+		renderPrepTask.get();
+		renderBatches.clear();
+	}
+}
+
+void GameInstance::setPipelinedRendering(bool pipelinedRendering) {
+	discardRenderPrep();
+	this->pipelinedRendering = pipelinedRendering;
+}
+
+void GameInstance::startRecording(int levelIndex) {
+	recording = true;
+	recordedReplay = Replay(levelIndex);
+}
+
+Replay GameInstance::stopRecording() {
+	recording = false;
+	return recordedReplay;
+}
+
+void GameInstance::loadReplay(const Replay& replay) {
+	playback = std::make_unique<Replay>(replay);
+	playbackFrameIndex = 0;
+	loadLevel(replay.getLevelIndex());
+}
+
+void GameInstance::simulateReplay() {
+	sf::Clock unusedClock;
+	float dt;
+	InputFrame input;
+	// Updates are only taken from the replay while unpaused so that none of them are skipped
+	while (playback && !paused && !gameInstanceCloseQueued && nextPhysicsUpdate(unusedClock, dt, input)) {
+		physicsUpdate(dt, input);
+	}
+}
+
+std::unique_ptr<RegistrySnapshot> GameInstance::takeSnapshot() {
+	return std::make_unique<RegistrySnapshot>(registry, *queue);
+}
+
+void GameInstance::restoreSnapshot(const RegistrySnapshot& snapshot) {
+	discardRenderPrep();
+	snapshot.restore(registry);
+	auto& levelManagerTag = registry.get<LevelManagerTag>();
+	reserveMemory(registry, std::max(INITIAL_ENTITY_RESERVATION, levelPack->getLevelProfile(levelManagerTag.getLevel()).expectedPeakEntityCount));
+
+	// Signals are shared with the snapshot so listeners are still connected, but nothing was emitted, so update the gui manually
+	onPlayerHPChange(registry.get<HealthComponent>(registry.attachee<PlayerTag>()).getHealth(), registry.get<HealthComponent>(registry.attachee<PlayerTag>()).getMaxHealth());
+	onPlayerPowerLevelChange(registry.get<PlayerTag>().getCurrentPowerTierIndex(), registry.get<PlayerTag>().getPowerTierCount(), registry.get<PlayerTag>().getCurrentPower());
+	onPointsChange(levelManagerTag.getPoints());
+	onPlayerBombCountChange(registry.get<PlayerTag>().getBombCount());
+
+	// The boss gui is shown again once the boss's next phase starts
+	onBossDespawn(currentBoss);
+	registry.view<EnemyComponent>().each([this](auto entity, EnemyComponent& enemy) {
+		onEnemySpawn(entity);
+	});
+}
+
 void GameInstance::handleEvent(sf::Event event) {
 	gui->handleEvent(event);
-	playerSystem->handleEvent(event);
+	keyboardInput.handleEvent(event);
 }
 
 void GameInstance::pause() {
 	paused = true;
+	keyboardInput.setPaused(true);
 }
 
 void GameInstance::resume() {
 	paused = false;
+	keyboardInput.setPaused(false);
 	playerSystem->onResume();
 }
 
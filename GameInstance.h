@@ -4,6 +4,7 @@
 #include <TGUI/TGUI.hpp>
 #include <memory>
 #include <vector>
+#include <future>
 #include "MovementSystem.h"
 #include "RenderSystem.h"
 #include "CollisionSystem.h"
@@ -15,6 +16,8 @@
 #include "PlayerSystem.h"
 #include "AudioPlayer.h"
 #include "CollectibleSystem.h"
+#include "PlayerInput.h"
+#include "RegistrySnapshot.h"
 
 class LevelPack;
 class LevelManagerTag;
@@ -44,6 +47,42 @@ public:
 	*/
 	void endLevel();
 
+	/*
+	Starts recording the player's inputs. Recording stops when stopRecording() is called.
+	The level should be loaded right after this is called so that the replay starts at the start of the level.
+	*/
+	void startRecording(int levelIndex);
+	/*
+	Stops recording and returns everything recorded since startRecording().
+	*/
+	Replay stopRecording();
+	/*
+	Loads the replay's level and makes start() use the replay's inputs and physics delta times instead
+	of the keyboard and clock, so that the session plays out exactly as it was recorded.
+	*/
+	void loadReplay(const Replay& replay);
+	/*
+	Runs every remaining update of the loaded replay as fast as possible without rendering.
+	*/
+	void simulateReplay();
+	/*
+	Sets whether render prep is pipelined with physics. Off by default.
+	When it is, the sprites of each frame are copied into a snapshot right after its physics updates, and their
+	batches are built on another thread while the next frame's physics updates run.
+	This shows every frame one frame late, and nothing is drawn in the first frame after a level is loaded.
+	*/
+	void setPipelinedRendering(bool pipelinedRendering);
+
+	/*
+	Takes a snapshot of every entity in the current level.
+	*/
+	std::unique_ptr<RegistrySnapshot> takeSnapshot();
+	/*
+	Returns the current level to the state it was in when the snapshot was taken.
+	The snapshot must have been taken by this game instance while in the same level.
+	*/
+	void restoreSnapshot(const RegistrySnapshot& snapshot);
+
 	void handleEvent(sf::Event event);
 	void pause();
 	void resume();
@@ -51,8 +90,23 @@ public:
 private:
 	void updateWindowView(int windowWidth, int windowHeight);
 
-	void physicsUpdate(float deltaTime);
+	/*
+	input - what the player is doing during this update
+	*/
+	void physicsUpdate(float deltaTime, InputFrame input);
+	/*
+	Returns the physics delta time and input for the next physics update and records them if recording.
+	Returns false if a replay is playing and it has no more updates.
+
+	clock - the clock measuring real time since the last physics update; unused when a replay is playing
+	*/
+	bool nextPhysicsUpdate(sf::Clock& clock, float& deltaTime, InputFrame& input);
 	void render(float deltaTime);
+	/*
+	Waits for the batches being built on another thread, if any, and throws them away
+	so that the next render doesn't draw an outdated frame.
+	*/
+	void discardRenderPrep();
 
 	bool gameInstanceCloseQueued = false;
 
@@ -74,6 +128,24 @@ private:
 	std::unique_ptr<CollectibleSystem> collectibleSystem;
 	std::unique_ptr<AudioPlayer> audioPlayer;
 
+	bool pipelinedRendering = false;
+	// Double-buffered so that one frame's batches can be built while the other's are drawn
+	// The last frame's sprites, read from another thread by renderPrepTask
+	RenderSnapshot renderSnapshot;
+	// Built from renderSnapshot by renderPrepTask, then drawn and cleared on this thread in the next render
+	RenderBatches renderBatches;
+	// Builds renderBatches; declared after them so that it is waited on before they are destroyed
+	std::future<void> renderPrepTask;
+
+	KeyboardInputSource keyboardInput;
+	// Whether inputs are being recorded into recordedReplay
+	bool recording = false;
+	Replay recordedReplay;
+	// The replay being played; nullptr if the keyboard is being used
+	std::unique_ptr<Replay> playback;
+	// Index of the next frame of playback
+	int playbackFrameIndex = 0;
+
 	bool paused;
 
 	// Total amount of points earned so far across all past levels.
@@ -0,0 +1,92 @@
+#pragma once
+#include "SpatialHashTable.h"
+
+/*
+Hierarchical spatial hash table
+
+Made up of levels of SpatialHashTables, where each level's cell size is double the cell size of the level before it.
+An object is inserted only into the first level whose cells are at least as wide as the object's hitbox,
+so every object overlaps at most 2x2 cells of its level no matter how large it is, and a few large objects
+do not force every other object into large cells.
+Levels with no objects in them are skipped when getting nearby objects.
+
+The table will not work for getting objects nearby objects that are outside map bounds.
+*/
+template<class T>
+class HierarchicalSpatialHashTable {
+public:
+	inline HierarchicalSpatialHashTable() {}
+	/*
+	smallestCellSize - the cell size of the first level
+	largestObjectRadius - the hitbox radius of the largest object that will be inserted, which decides the number of levels;
+		objects larger than this are inserted into the last level
+	*/
+	inline HierarchicalSpatialHashTable(float mapWidth, float mapHeight, float smallestCellSize, float largestObjectRadius) {
+		float cellSize = smallestCellSize;
+		levels.push_back(SpatialHashTable<T>(mapWidth, mapHeight, cellSize));
+		// A level with cells larger than the map would be the same as the level before it
+		while (cellSize < 2.0f * largestObjectRadius && cellSize < std::max(mapWidth, mapHeight)) {
+			cellSize *= 2.0f;
+			levels.push_back(SpatialHashTable<T>(mapWidth, mapHeight, cellSize));
+		}
+		levelObjectsCount = std::vector<int>(levels.size(), 0);
+	}
+
+	inline void clear() {
+		for (int i = 0; i < levels.size(); i++) {
+			if (levelObjectsCount[i] > 0) {
+				levels[i].clear();
+				levelObjectsCount[i] = 0;
+			}
+		}
+	}
+
+	/*
+	Returns false if the object was not inserted because it is completely outside the map.
+	*/
+	inline bool insert(T object, float hitboxX, float hitboxY, float hitboxRadius, const PositionComponent& position) {
+		int level = getLevel(hitboxRadius);
+		if (levels[level].insert(object, hitboxX, hitboxY, hitboxRadius, position)) {
+			levelObjectsCount[level]++;
+			return true;
+		}
+		return false;
+	}
+
+	inline bool insert(T object, const HitboxComponent& hitbox, const PositionComponent& position) {
+		return insert(object, hitbox.getX(), hitbox.getY(), hitbox.getRadius(), position);
+	}
+
+	/*
+	Appends the objects in every cell that overlaps the hitbox to dest.
+	An object that is in multiple of those cells is appended once for each of them.
+	*/
+	inline void getNearbyObjects(const HitboxComponent& hitbox, const PositionComponent& position, std::vector<T>& dest) {
+		for (int i = 0; i < levels.size(); i++) {
+			if (levelObjectsCount[i] > 0) {
+				levels[i].getNearbyObjects(hitbox, position, dest);
+			}
+		}
+	}
+
+	inline int getLevelsCount() const { return levels.size(); }
+	inline float getCellSize(int level) const { return levels[level].getCellSize(); }
+	/*
+	Returns the number of objects inserted into a level since the last clear().
+	*/
+	inline int getObjectsCount(int level) const { return levelObjectsCount[level]; }
+
+private:
+	std::vector<SpatialHashTable<T>> levels;
+	// Number of objects in each level
+	std::vector<int> levelObjectsCount;
+
+	inline int getLevel(float hitboxRadius) const {
+		for (int i = 0; i < levels.size() - 1; i++) {
+			if (2.0f * hitboxRadius <= levels[i].getCellSize()) {
+				return i;
+			}
+		}
+		return levels.size() - 1;
+	}
+};
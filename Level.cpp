@@ -12,6 +12,7 @@ std::string Level::format() const {
 	for (auto settings : bloomLayerSettings) {
 		res += formatTMObject(settings);
 	}
+	res += tos(cullingMargin);
 	return res;
 }
 
@@ -62,6 +63,12 @@ void Level::load(std::string formattedString) {
 		settings.load(items[i++]);
 		bloomLayerSettings[a] = settings;
 	}
+	// Levels saved before culling margins existed don't have one
+	if (i < items.size()) {
+		cullingMargin = std::stof(items[i++]);
+	} else {
+		cullingMargin = -1;
+	}
 }
 
 bool Level::legal(std::string & message) const {
@@ -69,7 +69,10 @@ public:
 	inline std::vector<BloomSettings>& getBloomLayerSettings() { return bloomLayerSettings; }
 	inline float getBackgroundTextureWidth() const { return backgroundTextureWidth; }
 	inline float getBackgroundTextureHeight() const { return backgroundTextureHeight; }
+	inline float getCullingMargin() const { return cullingMargin; }
 	inline bool usesEnemy(int enemyID) const { return enemyIDCount.count(enemyID) > 0 && enemyIDCount.at(enemyID) > 0; }
+	// Returns a map of the IDs of every EditorEnemy this Level uses to the number of times it is used
+	inline const std::map<int, int>& getEnemyIDCount() const { return enemyIDCount; }
 
 	inline void setName(std::string name) { this->name = name; }
 	inline void setBackgroundFileName(std::string backgroundFileName) { this->backgroundFileName = backgroundFileName; }
@@ -79,6 +82,7 @@ public:
 	inline void setBossHPBarColor(sf::Color bossHPBarColor) { this->bossHPBarColor = bossHPBarColor; }
 	inline float setBackgroundTextureWidth(float backgroundTextureWidth) { this->backgroundTextureWidth = backgroundTextureWidth; }
 	inline float setBackgroundTextureHeight(float backgroundTextureHeight) { this->backgroundTextureHeight = backgroundTextureHeight; }
+	inline void setCullingMargin(float cullingMargin) { this->cullingMargin = cullingMargin; }
 
 	/*
 	Insert a LevelEvent at index eventIndex.
@@ -96,6 +100,14 @@ public:
 	Returns whether the start condition for the LevelEvent at index conditionIndex has been satisfied.
 	*/
 	inline bool conditionSatisfied(int conditionIndex, entt::DefaultRegistry& registry) const { return events[conditionIndex].first->satisfied(registry); }
+	/*
+	Returns the time since the start of the level at which the start condition for the LevelEvent at index conditionIndex
+	will be satisfied, or a negative number if it cannot be satisfied until an enemy spawns or despawns.
+	See LevelEventStartCondition::getSatisfiedTime().
+	*/
+	inline float getConditionSatisfiedTime(int conditionIndex, float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const {
+		return events[conditionIndex].first->getSatisfiedTime(timeSinceStartOfLevel, timeSinceLastEnemySpawn, enemiesAlive);
+	}
 
 private:
 	// Name of the level
@@ -128,6 +140,10 @@ private:
 	// Bloom settings for the level; each index is a separate layer
 	std::vector<BloomSettings> bloomLayerSettings = std::vector<BloomSettings>(HIGHEST_RENDER_LAYER + 1, BloomSettings());
 
+	// Distance outside the play area beyond which bullets that can never come back are despawned early.
+	// Should be larger than the largest bullet sprite. Negative if bullets should never be despawned early.
+	float cullingMargin = -1;
+
 	// Maps an EditorEnemy ID to the number of times it will be spawned in events.
 	// This is not saved on format() but is reconstructed in load().
 	std::map<int, int> enemyIDCount;
@@ -14,6 +14,10 @@ bool GlobalTimeBasedEnemySpawnCondition::satisfied(entt::DefaultRegistry & regis
 	return registry.get<LevelManagerTag>().getTimeSinceStartOfLevel() >= time;
 }
 
+float GlobalTimeBasedEnemySpawnCondition::getSatisfiedTime(float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const {
+	return time;
+}
+
 std::string EnemyCountBasedEnemySpawnCondition::format() const {
 	return formatString("EnemyCountBasedEnemySpawnCondition") + tos(enemyCount);
 }
@@ -24,7 +28,15 @@ void EnemyCountBasedEnemySpawnCondition::load(std::string formattedString) {
 }
 
 bool EnemyCountBasedEnemySpawnCondition::satisfied(entt::DefaultRegistry & registry) {
-	return registry.view<EnemyComponent>().size() - 1 <= enemyCount;
+	return registry.get<LevelManagerTag>().getEnemiesAlive() - 1 <= enemyCount;
+}
+
+float EnemyCountBasedEnemySpawnCondition::getSatisfiedTime(float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const {
+	if (enemiesAlive - 1 <= enemyCount) {
+		return timeSinceStartOfLevel;
+	}
+	// Enemy count can only change on an enemy spawn or despawn
+	return -1;
 }
 
 std::string TimeBasedEnemySpawnCondition::format() const {
@@ -40,6 +52,10 @@ bool TimeBasedEnemySpawnCondition::satisfied(entt::DefaultRegistry & registry) {
 	return registry.get<LevelManagerTag>().getTimeSinceLastEnemySpawn() >= time;
 }
 
+float TimeBasedEnemySpawnCondition::getSatisfiedTime(float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const {
+	return timeSinceStartOfLevel + std::max(0.0f, time - timeSinceLastEnemySpawn);
+}
+
 std::shared_ptr<LevelEventStartCondition> LevelEventStartConditionFactory::create(std::string formattedString) {
 	auto name = split(formattedString, DELIMITER)[0];
 	std::shared_ptr<LevelEventStartCondition> ptr;
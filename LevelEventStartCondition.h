@@ -11,6 +11,16 @@ public:
 	void load(std::string formattedString) = 0;
 
 	virtual bool satisfied(entt::DefaultRegistry& registry) = 0;
+	/*
+	Returns the time since the start of the level at which this condition will be satisfied, assuming
+	no enemies spawn or despawn before then, or a negative number if this condition cannot be satisfied
+	until an enemy spawns or despawns.
+
+	timeSinceStartOfLevel - the current time since the start of the level
+	timeSinceLastEnemySpawn - the current time since the last enemy spawn
+	enemiesAlive - the number of enemies currently alive
+	*/
+	virtual float getSatisfiedTime(float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const = 0;
 };
 
 /*
@@ -25,6 +35,7 @@ public:
 	void load(std::string formattedString) override;
 
 	bool satisfied(entt::DefaultRegistry& registry) override;
+	float getSatisfiedTime(float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const override;
 
 private:
 	// Minimum time since the start of the level for this condition to be satisfied
@@ -43,6 +54,7 @@ public:
 	void load(std::string formattedString) override;
 
 	bool satisfied(entt::DefaultRegistry& registry) override;
+	float getSatisfiedTime(float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const override;
 
 private:
 	// Minimum time since the last enemy's spawn for this condition to be satisfied
@@ -61,6 +73,7 @@ public:
 	void load(std::string formattedString) override;
 
 	bool satisfied(entt::DefaultRegistry& registry) override;
+	float getSatisfiedTime(float timeSinceStartOfLevel, float timeSinceLastEnemySpawn, int enemiesAlive) const override;
 
 private:
 	// Maximum number of other enemies alive for this condition to be satisfied
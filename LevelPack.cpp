@@ -1,5 +1,8 @@
 #include "LevelPack.h"
 #include <fstream>
+#include <future>
+#include <boost/filesystem.hpp>
+#include <boost/log/trivial.hpp>
 #include "TextFileParser.h"
 #include "Attack.h"
 #include "AttackPattern.h"
@@ -24,6 +27,7 @@
 
 LevelPack::LevelPack(AudioPlayer& audioPlayer, std::string name) : audioPlayer(audioPlayer), name(name) {
 	onChange = std::make_shared<entt::SigH<void()>>();
+	onChange->sink().connect<LevelPack, &LevelPack::clearLevelProfiles>(this);
 
 
 	/*
@@ -260,154 +264,323 @@ LevelPack::LevelPack(AudioPlayer& audioPlayer, std::string name) : audioPlayer(a
 	//load();
 }
 
+LevelPack::~LevelPack() {
+	waitForPendingSave();
+	onChange->sink().disconnect<LevelPack, &LevelPack::clearLevelProfiles>(this);
+}
+
+/*
+Writes contents into the file at path without ever leaving the file half-written.
+The contents are written to a temporary file, which then replaces the file.
+Returns whether the file was replaced.
+*/
+static bool writeFileAtomically(const std::string& path, const std::string& contents) {
+	std::string tempPath = path + ".tmp";
+	{
+		std::ofstream file(tempPath);
+		file << contents;
+		file.close();
+		if (!file) {
+			BOOST_LOG_TRIVIAL(error) << "Unable to write to \"" + tempPath + "\"";
+			return false;
+		}
+	}
+
+	boost::system::error_code error;
+	boost::filesystem::rename(tempPath, path, error);
+	if (error) {
+		BOOST_LOG_TRIVIAL(error) << "Unable to replace \"" + path + "\"; " + error.message();
+		return false;
+	}
+	return true;
+}
+
+/*
+Reads a level pack object file, in which the first line is the next ID and every other line is the data for an object.
+
+Returns a pair of the next ID and a map of object ID to object.
+
+formattedObjects - filled with each object ID mapped to the line it was loaded from
+*/
+template<class T>
+static std::pair<int, std::map<int, std::shared_ptr<T>>> loadObjectFile(const std::string& fileName, const std::string& idConflictMessage, std::map<int, std::string>& formattedObjects) {
+	std::map<int, std::shared_ptr<T>> objects;
+	std::ifstream file(fileName);
+	std::string line;
+	std::getline(file, line);
+	int nextID = std::stoi(line);
+	while (std::getline(file, line)) {
+		std::shared_ptr<T> object = std::make_shared<T>();
+		object->load(line);
+		assert(objects.count(object->getID()) == 0 && idConflictMessage.c_str());
+		objects[object->getID()] = object;
+		formattedObjects[object->getID()] = line;
+	}
+	file.close();
+	return std::make_pair(nextID, objects);
+}
+
+/*
+Reads a level pack object file without constructing any objects.
+Each object is mapped by ID to the line it is on so that it can be constructed later with loadUnloadedObject().
+
+Returns a pair of the next ID and the IDs of every object in the file.
+
+formattedObjects - filled with each object ID mapped to the line it was loaded from
+*/
+static std::pair<int, std::set<int>> indexObjectFile(const std::string& fileName, const std::string& idConflictMessage, std::map<int, std::string>& formattedObjects) {
+	std::set<int> ids;
+	std::ifstream file(fileName);
+	std::string line;
+	std::getline(file, line);
+	int nextID = std::stoi(line);
+	while (std::getline(file, line)) {
+		// The ID is always the first item in a formatted object
+		int id = std::stoi(line.substr(0, line.find(DELIMITER)));
+		assert(ids.count(id) == 0 && idConflictMessage.c_str());
+		ids.insert(id);
+		formattedObjects[id] = line;
+	}
+	file.close();
+	return std::make_pair(nextID, ids);
+}
+
+/*
+Returns the object with ID id, constructing it from its ObjectFileCache if it has not been constructed yet.
+*/
+template<class T>
+static std::shared_ptr<T> loadUnloadedObject(int id, std::map<int, std::shared_ptr<T>>& objects, std::set<int>& unloaded, const ObjectFileCache& cache) {
+	if (unloaded.count(id) == 0) {
+		return objects.at(id);
+	}
+	std::shared_ptr<T> object = std::make_shared<T>();
+	object->load(cache.getFormattedObject(id));
+	objects[id] = object;
+	unloaded.erase(id);
+	return object;
+}
+
+/*
+Constructs every object that has not been constructed yet.
+
+Returns the newly constructed objects.
+*/
+template<class T>
+static std::vector<std::shared_ptr<T>> loadUnloadedObjects(std::map<int, std::shared_ptr<T>>& objects, std::set<int>& unloaded, const ObjectFileCache& cache) {
+	std::vector<std::shared_ptr<T>> loaded;
+	while (!unloaded.empty()) {
+		loaded.push_back(loadUnloadedObject(*unloaded.begin(), objects, unloaded, cache));
+	}
+	return loaded;
+}
+
 void LevelPack::load() {
 	// First line is always the next ID
 	// Every other line is the data for the object
 
-	// Read metafile
-	{
-		std::ifstream metafile("Level Packs\\" + name + "\\meta.txt");
+	loadTimeReport.clear();
+	ScopedLoadStageTimer totalTimer(loadTimeReport, "Total");
+
+	std::string folder = "Level Packs\\" + name + "\\";
+
+	// Waiting for a pending save is necessary to not read half-renamed files
+	waitForPendingSave();
+
+	// Every file is independent of the others, so they are all parsed concurrently into local maps
+	// and only moved into this LevelPack once every task is done
+	auto metafileTask = std::async(std::launch::async, [this, folder]() {
+		ScopedLoadStageTimer timer(loadTimeReport, "Parse meta.txt");
+		std::ifstream metafile(folder + "meta.txt");
 		std::string line;
 		std::getline(metafile, line);
-		metadata.load(line);
+		LevelPackMetadata loadedMetadata;
+		loadedMetadata.load(line);
+		metafileCache = line + "\n";
 		std::getline(metafile, line);
-		fontFileName = line;
+		metafileCache += line + "\n";
+		return std::make_pair(loadedMetadata, line);
+	});
+	auto levelsTask = std::async(std::launch::async, [this, folder]() {
+		ScopedLoadStageTimer timer(loadTimeReport, "Parse levels.txt");
+		std::vector<std::shared_ptr<Level>> loadedLevels;
+		std::ifstream levelsFile(folder + "levels.txt");
+		std::string line;
+		levelsFileCache.clear();
+		while (std::getline(levelsFile, line)) {
+			std::shared_ptr<Level> level = std::make_shared<Level>();
+			level->load(line);
+			loadedLevels.push_back(level);
+			levelsFileCache += line + "\n";
+		}
+		levelsFile.close();
+		return loadedLevels;
+	});
+	// Bullet models are constructed immediately since every EditorAttack needs them as soon as it is constructed
+	std::map<int, std::string> formattedBulletModels;
+	auto bulletModelsTask = std::async(std::launch::async, [this, folder, &formattedBulletModels]() {
+		ScopedLoadStageTimer timer(loadTimeReport, "Parse bullet_models.txt");
+		return loadObjectFile<BulletModel>(folder + "bullet_models.txt", "Bullet model ID conflict", formattedBulletModels);
+	});
+	std::map<int, std::string> formattedAttacks;
+	auto attacksTask = std::async(std::launch::async, [this, folder, &formattedAttacks]() {
+		ScopedLoadStageTimer timer(loadTimeReport, "Index attacks.txt");
+		return indexObjectFile(folder + "attacks.txt", "Attack ID conflict", formattedAttacks);
+	});
+	std::map<int, std::string> formattedAttackPatterns;
+	auto attackPatternsTask = std::async(std::launch::async, [this, folder, &formattedAttackPatterns]() {
+		ScopedLoadStageTimer timer(loadTimeReport, "Index attack_patterns.txt");
+		return indexObjectFile(folder + "attack_patterns.txt", "Attack pattern ID conflict", formattedAttackPatterns);
+	});
+	std::map<int, std::string> formattedEnemies;
+	auto enemiesTask = std::async(std::launch::async, [this, folder, &formattedEnemies]() {
+		ScopedLoadStageTimer timer(loadTimeReport, "Index enemies.txt");
+		return indexObjectFile(folder + "enemies.txt", "Enemy ID conflict", formattedEnemies);
+	});
+	std::map<int, std::string> formattedEnemyPhases;
+	auto enemyPhasesTask = std::async(std::launch::async, [this, folder, &formattedEnemyPhases]() {
+		ScopedLoadStageTimer timer(loadTimeReport, "Index enemy_phases.txt");
+		return indexObjectFile(folder + "enemy_phases.txt", "Enemy phase ID conflict", formattedEnemyPhases);
+	});
+
+	// Join
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	auto loadedMetadata = metafileTask.get();
+	metadata = loadedMetadata.first;
+	fontFileName = loadedMetadata.second;
+
+	auto loadedLevels = levelsTask.get();
+	levels.insert(levels.end(), loadedLevels.begin(), loadedLevels.end());
+
+	auto loadedBulletModels = bulletModelsTask.get();
+	nextBulletModelID = loadedBulletModels.first;
+	bulletModels = loadedBulletModels.second;
+	bulletModelsFileCache.setLoaded(formattedBulletModels);
+
+	auto loadedAttacks = attacksTask.get();
+	nextAttackID = loadedAttacks.first;
+	attacks.clear();
+	unloadedAttacks = loadedAttacks.second;
+	attacksFileCache.setLoaded(formattedAttacks);
+
+	auto loadedAttackPatterns = attackPatternsTask.get();
+	nextAttackPatternID = loadedAttackPatterns.first;
+	attackPatterns.clear();
+	unloadedAttackPatterns = loadedAttackPatterns.second;
+	attackPatternsFileCache.setLoaded(formattedAttackPatterns);
+
+	auto loadedEnemies = enemiesTask.get();
+	nextEnemyID = loadedEnemies.first;
+	enemies.clear();
+	unloadedEnemies = loadedEnemies.second;
+	enemiesFileCache.setLoaded(formattedEnemies);
+
+	auto loadedEnemyPhases = enemyPhasesTask.get();
+	nextEnemyPhaseID = loadedEnemyPhases.first;
+	enemyPhases.clear();
+	unloadedEnemyPhases = loadedEnemyPhases.second;
+	enemyPhasesFileCache.setLoaded(formattedEnemyPhases);
+
+	bulletModelUsersIndex.clear();
+	attackUsersIndex.clear();
+	attackPatternUsersIndex.clear();
+	enemyPhaseUsersIndex.clear();
+}
+
+bool LevelPack::save(bool inBackground) {
+	// Don't let two saves write the same files at the same time
+	waitForPendingSave();
+	// Formatting reads every constructed object
+	std::unique_lock<std::recursive_mutex> lock(objectsMutex);
+
+	std::string folder = "Level Packs\\" + name + "\\";
+	// Pairs of file path and new file contents
+	std::vector<std::pair<std::string, std::string>> changedFiles;
+	// Caches are only updated once their file is known to have been written
+	pendingSaveCommits.clear();
+
+	// Levels are modified in place rather than through update______(), so the metafile and levels file
+	// are always reformatted and only compared against what was last saved
+	std::string metafileContents = metadata.format() + "\n" + fontFileName + "\n";
+	if (metafileContents != metafileCache) {
+		changedFiles.push_back(std::make_pair(folder + "meta.txt", metafileContents));
+		pendingSaveCommits.push_back([this, metafileContents](bool written) {
+			if (written) {
+				metafileCache = metafileContents;
+			}
+		});
 	}
 
-	// Read levels
-	std::ifstream levelsFile("Level Packs\\" + name + "\\levels.txt");
-	std::string line;
-	while (std::getline(levelsFile, line)) {
-		std::shared_ptr<Level> level = std::make_shared<Level>();
-		level->load(line);
-		levels.push_back(level);
-	}
-	levelsFile.close();
-
-	// Read bullet models
-	std::ifstream bulletModelsFile("Level Packs\\" + name + "\\bullet_models.txt");
-	std::getline(bulletModelsFile, line);
-	nextBulletModelID = std::stoi(line);
-	while (std::getline(bulletModelsFile, line)) {
-		std::shared_ptr<BulletModel> bulletModel = std::make_shared<BulletModel>();
-		bulletModel->load(line);
-		assert(bulletModels.count(bulletModel->getID()) == 0 && "Bullet model ID conflict");
-		bulletModels[bulletModel->getID()] = bulletModel;
-	}
-	bulletModelsFile.close();
-
-	// Read attacks
-	std::ifstream attacksFile("Level Packs\\" + name + "\\attacks.txt");
-	std::getline(attacksFile, line);
-	nextAttackID = std::stoi(line);
-	while (std::getline(attacksFile, line)) {
-		std::shared_ptr<EditorAttack> attack = std::make_shared<EditorAttack>();
-		attack->load(line);
-		// Load bullet models for every EMP
-		attack->loadEMPBulletModels(*this);
-		assert(attacks.count(attack->getID()) == 0 && "Attack ID conflict");
-		attacks[attack->getID()] = attack;
-	}
-	attacksFile.close();
-
-	// Read attack patterns
-	std::ifstream attackPatternsFile("Level Packs\\" + name + "\\attack_patterns.txt");
-	std::getline(attackPatternsFile, line);
-	nextAttackPatternID = std::stoi(line);
-	while (std::getline(attackPatternsFile, line)) {
-		std::shared_ptr<EditorAttackPattern> attackPattern = std::make_shared<EditorAttackPattern>();
-		attackPattern->load(line);
-		assert(attackPatterns.count(attackPattern->getID()) == 0 && "Attack pattern ID conflict");
-		attackPatterns[attackPattern->getID()] = attackPattern;
-	}
-	attackPatternsFile.close();
-
-	// Read enemies
-	std::ifstream enemiesFile("Level Packs\\" + name + "\\enemies.txt");
-	std::getline(enemiesFile, line);
-	nextEnemyID = std::stoi(line);
-	while (std::getline(enemiesFile, line)) {
-		std::shared_ptr<EditorEnemy> enemy = std::make_shared<EditorEnemy>();
-		enemy->load(line);
-		assert(enemies.count(enemy->getID()) == 0 && "Enemy ID conflict");
-		enemies[enemy->getID()] = enemy;
-	}
-	enemiesFile.close();
-
-	// Read enemy phases
-	std::ifstream enemyPhasesFile("Level Packs\\" + name + "\\enemy_phases.txt");
-	std::getline(enemyPhasesFile, line);
-	nextEnemyPhaseID = std::stoi(line);
-	while (std::getline(enemyPhasesFile, line)) {
-		std::shared_ptr<EditorEnemyPhase> enemyPhase = std::make_shared<EditorEnemyPhase>();
-		enemyPhase->load(line);
-		assert(enemyPhases.count(enemyPhase->getID()) == 0 && "Enemy phase ID conflict");
-		enemyPhases[enemyPhase->getID()] = enemyPhase;
-	}
-	enemyPhasesFile.close();
-}
-
-void LevelPack::save() {
-	// Save metafile
-	std::ofstream metafile("Level Packs\\" + name + "\\meta.txt");
-	metafile << metadata.format() << std::endl;
-	metafile << fontFileName << std::endl;
-
-	// Save levels
-	std::ofstream levelsFile("Level Packs\\" + name + "\\levels.txt");
+	std::string levelsFileContents;
 	for (auto level : levels) {
-		levelsFile << level->format() << std::endl;
+		levelsFileContents += level->format() + "\n";
 	}
-	levelsFile.close();
-
-	// Save bullet models
-	std::ofstream bulletModelsFile("Level Packs\\" + name + "\\bullet_models.txt");
-	bulletModelsFile << nextBulletModelID << std::endl;
-	for (auto p : bulletModels) {
-		bulletModelsFile << p.second->format() << std::endl;
+	if (levelsFileContents != levelsFileCache) {
+		changedFiles.push_back(std::make_pair(folder + "levels.txt", levelsFileContents));
+		pendingSaveCommits.push_back([this, levelsFileContents](bool written) {
+			if (written) {
+				levelsFileCache = levelsFileContents;
+			}
+		});
 	}
-	bulletModelsFile.close();
 
-	// Save attacks
-	std::ofstream attacksFile("Level Packs\\" + name + "\\attacks.txt");
-	attacksFile << nextAttackID << std::endl;
-	for (auto p : attacks) {
-		// Skip if ID < 0, because that signifies that it's a temporary EditorAttack
-		if (p.first < 0) continue;
-		attacksFile << p.second->format() << std::endl;
+	// Objects with ID < 0 are temporary, so they are never saved
+	std::string fileContents;
+	if (bulletModelsFileCache.format(nextBulletModelID, bulletModels, fileContents)) {
+		changedFiles.push_back(std::make_pair(folder + "bullet_models.txt", fileContents));
+		pendingSaveCommits.push_back([this](bool written) { bulletModelsFileCache.commit(written); });
+	}
+	if (attacksFileCache.format(nextAttackID, attacks, fileContents)) {
+		changedFiles.push_back(std::make_pair(folder + "attacks.txt", fileContents));
+		pendingSaveCommits.push_back([this](bool written) { attacksFileCache.commit(written); });
+	}
+	if (attackPatternsFileCache.format(nextAttackPatternID, attackPatterns, fileContents)) {
+		changedFiles.push_back(std::make_pair(folder + "attack_patterns.txt", fileContents));
+		pendingSaveCommits.push_back([this](bool written) { attackPatternsFileCache.commit(written); });
+	}
+	if (enemiesFileCache.format(nextEnemyID, enemies, fileContents)) {
+		changedFiles.push_back(std::make_pair(folder + "enemies.txt", fileContents));
+		pendingSaveCommits.push_back([this](bool written) { enemiesFileCache.commit(written); });
+	}
+	if (enemyPhasesFileCache.format(nextEnemyPhaseID, enemyPhases, fileContents)) {
+		changedFiles.push_back(std::make_pair(folder + "enemy_phases.txt", fileContents));
+		pendingSaveCommits.push_back([this](bool written) { enemyPhasesFileCache.commit(written); });
 	}
-	attacksFile.close();
 
-	// Save attack patterns
-	std::ofstream attackPatternsFile("Level Packs\\" + name + "\\attack_patterns.txt");
-	attackPatternsFile << nextAttackPatternID << std::endl;
-	for (auto p : attackPatterns) {
-		if (p.first < 0) continue;
-		attackPatternsFile << p.second->format() << std::endl;
+	// Everything has been formatted, so the files can be written without touching this LevelPack
+	auto writeChangedFiles = [changedFiles]() {
+		std::vector<bool> written;
+		for (auto& p : changedFiles) {
+			written.push_back(writeFileAtomically(p.first, p.second));
+		}
+		return written;
+	};
+	pendingSave = std::async(inBackground ? std::launch::async : std::launch::deferred, writeChangedFiles);
+	lock.unlock();
+	if (inBackground) {
+		return true;
 	}
-	attackPatternsFile.close();
+	return waitForPendingSave();
+}
 
-	// Save enemies
-	std::ofstream enemiesFile("Level Packs\\" + name + "\\enemies.txt");
-	enemiesFile << nextEnemyID << std::endl;
-	for (auto p : enemies) {
-		if (p.first < 0) continue;
-		enemiesFile << p.second->format() << std::endl;
+bool LevelPack::waitForPendingSave() {
+	if (!pendingSave.valid()) {
+		return true;
 	}
-	enemiesFile.close();
 
-	// Save enemy phases
-	std::ofstream enemyPhasesFile("Level Packs\\" + name + "\\enemy_phases.txt");
-	enemyPhasesFile << nextEnemyPhaseID << std::endl;
-	for (auto p : enemyPhases) {
-		if (p.first < 0) continue;
-		enemyPhasesFile << p.second->format() << std::endl;
+	// The caches are committed on this thread since they can be read at any time
+	std::vector<bool> written = pendingSave.get();
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	bool allWritten = true;
+	for (int i = 0; i < written.size(); i++) {
+		pendingSaveCommits[i](written[i]);
+		allWritten = allWritten && written[i];
 	}
-	enemyPhasesFile.close();
+	pendingSaveCommits.clear();
+	return allWritten;
 }
 
-std::unique_ptr<SpriteLoader> LevelPack::createSpriteLoader() {
-	std::unique_ptr<SpriteLoader> spriteLoader = std::make_unique<SpriteLoader>("Level Packs\\" + name, metadata.getSpriteSheets());
+std::unique_ptr<SpriteLoader> LevelPack::createSpriteLoader(bool createTextures) {
+	std::unique_ptr<SpriteLoader> spriteLoader = std::make_unique<SpriteLoader>("Level Packs\\" + name, metadata.getSpriteSheets(), createTextures);
 	return std::move(spriteLoader);
 }
 
@@ -417,29 +590,37 @@ void LevelPack::insertLevel(int index, std::shared_ptr<Level> level) {
 }
 
 std::shared_ptr<EditorAttack> LevelPack::createAttack() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	auto attack = std::make_shared<EditorAttack>(nextAttackID++);
 	attacks[attack->getID()] = attack;
+	attacksFileCache.markDirty(attack->getID());
 	onChange->publish();
 	return attack;
 }
 
 std::shared_ptr<EditorAttackPattern> LevelPack::createAttackPattern() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	auto attackPattern = std::make_shared<EditorAttackPattern>(nextAttackPatternID++);
 	attackPatterns[attackPattern->getID()] = attackPattern;
+	attackPatternsFileCache.markDirty(attackPattern->getID());
 	onChange->publish();
 	return attackPattern;
 }
 
 std::shared_ptr<EditorEnemy> LevelPack::createEnemy() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	auto enemy = std::make_shared<EditorEnemy>(nextEnemyID++);
 	enemies[enemy->getID()] = enemy;
+	enemiesFileCache.markDirty(enemy->getID());
 	onChange->publish();
 	return enemy;
 }
 
 std::shared_ptr<EditorEnemyPhase> LevelPack::createEnemyPhase() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	auto enemyPhase = std::make_shared<EditorEnemyPhase>(nextEnemyPhaseID++);
 	enemyPhases[enemyPhase->getID()] = enemyPhase;
+	enemyPhasesFileCache.markDirty(enemyPhase->getID());
 	onChange->publish();
 	return enemyPhase;
 }
@@ -447,32 +628,58 @@ std::shared_ptr<EditorEnemyPhase> LevelPack::createEnemyPhase() {
 std::shared_ptr<BulletModel> LevelPack::createBulletModel() {
 	auto bulletModel = std::make_shared<BulletModel>(nextBulletModelID++);
 	bulletModels[bulletModel->getID()] = bulletModel;
+	bulletModelsFileCache.markDirty(bulletModel->getID());
 	onChange->publish();
 	return bulletModel;
 }
 
 void LevelPack::updateAttack(std::shared_ptr<EditorAttack> attack) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	attacks[attack->getID()] = attack;
+	unloadedAttacks.erase(attack->getID());
+	attacksFileCache.markDirty(attack->getID());
+	if (bulletModelUsersIndex.isBuilt()) {
+		bulletModelUsersIndex.setUses(attack->getID(), attack->getBulletModelIDCount());
+	}
 	onChange->publish();
 }
 
 void LevelPack::updateAttackPattern(std::shared_ptr<EditorAttackPattern> attackPattern) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	attackPatterns[attackPattern->getID()] = attackPattern;
+	unloadedAttackPatterns.erase(attackPattern->getID());
+	attackPatternsFileCache.markDirty(attackPattern->getID());
+	if (attackUsersIndex.isBuilt()) {
+		attackUsersIndex.setUses(attackPattern->getID(), attackPattern->getAttackIDCount());
+	}
 	onChange->publish();
 }
 
 void LevelPack::updateEnemy(std::shared_ptr<EditorEnemy> enemy) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	enemies[enemy->getID()] = enemy;
+	unloadedEnemies.erase(enemy->getID());
+	enemiesFileCache.markDirty(enemy->getID());
+	if (enemyPhaseUsersIndex.isBuilt()) {
+		enemyPhaseUsersIndex.setUses(enemy->getID(), enemy->getEnemyPhaseIDCount());
+	}
 	onChange->publish();
 }
 
 void LevelPack::updateEnemyPhase(std::shared_ptr<EditorEnemyPhase> enemyPhase) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	enemyPhases[enemyPhase->getID()] = enemyPhase;
+	unloadedEnemyPhases.erase(enemyPhase->getID());
+	enemyPhasesFileCache.markDirty(enemyPhase->getID());
+	if (attackPatternUsersIndex.isBuilt()) {
+		attackPatternUsersIndex.setUses(enemyPhase->getID(), enemyPhase->getAttackPatternIDCount());
+	}
 	onChange->publish();
 }
 
 void LevelPack::updateBulletModel(std::shared_ptr<BulletModel> bulletModel) {
 	bulletModels[bulletModel->getID()] = bulletModel;
+	bulletModelsFileCache.markDirty(bulletModel->getID());
 	onChange->publish();
 }
 
@@ -482,31 +689,50 @@ void LevelPack::deleteLevel(int levelIndex) {
 }
 
 void LevelPack::deleteAttack(int id) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	attacks.erase(id);
+	unloadedAttacks.erase(id);
+	attacksFileCache.markDirty(id);
+	bulletModelUsersIndex.removeUser(id);
 	onChange->publish();
 }
 
 void LevelPack::deleteAttackPattern(int id) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	attackPatterns.erase(id);
+	unloadedAttackPatterns.erase(id);
+	attackPatternsFileCache.markDirty(id);
+	attackUsersIndex.removeUser(id);
 	onChange->publish();
 }
 
 void LevelPack::deleteEnemy(int id) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	enemies.erase(id);
+	unloadedEnemies.erase(id);
+	enemiesFileCache.markDirty(id);
+	enemyPhaseUsersIndex.removeUser(id);
 	onChange->publish();
 }
 
 void LevelPack::deleteEnemyPhase(int id) {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
 	enemyPhases.erase(id);
+	unloadedEnemyPhases.erase(id);
+	enemyPhasesFileCache.markDirty(id);
+	attackPatternUsersIndex.removeUser(id);
 	onChange->publish();
 }
 
 void LevelPack::deleteBulletModel(int id) {
 	bulletModels.erase(id);
+	bulletModelsFileCache.markDirty(id);
 	onChange->publish();
 }
 
 std::vector<int> LevelPack::getEnemyUsers(int enemyID) {
+	// Levels are modified in place rather than through an update function, so there is no index to keep up to date.
+	// There are few enough levels that scanning them is cheap.
 	std::vector<int> results;
 	for (int i = 0; i < levels.size(); i++) {
 		if (levels[i]->usesEnemy(enemyID)) {
@@ -517,13 +743,7 @@ std::vector<int> LevelPack::getEnemyUsers(int enemyID) {
 }
 
 std::vector<int> LevelPack::getEditorEnemyUsers(int editorEnemyPhaseID) {
-	std::vector<int> results;
-	for (auto it = enemies.begin(); it != enemies.end(); it++) {
-		if (it->second->usesEnemyPhase(editorEnemyPhaseID)) {
-			results.push_back(it->first);
-		}
-	}
-	return results;
+	return getEnemyPhaseUsersIndex().getUsers(editorEnemyPhaseID);
 }
 
 bool LevelPack::attackPatternIsUsedByPlayer(int attackPatternID) {
@@ -531,49 +751,276 @@ bool LevelPack::attackPatternIsUsedByPlayer(int attackPatternID) {
 }
 
 std::vector<int> LevelPack::getAttackPatternEnemyUsers(int attackPatternID) {
-	std::vector<int> results;
-	for (auto it = enemyPhases.begin(); it != enemyPhases.end(); it++) {
-		if (it->second->usesAttackPattern(attackPatternID)) {
-			results.push_back(it->first);
+	return getAttackPatternUsersIndex().getUsers(attackPatternID);
+}
+
+std::vector<int> LevelPack::getAttackUsers(int attackID) {
+	return getAttackUsersIndex().getUsers(attackID);
+}
+
+std::vector<int> LevelPack::getBulletModelUsers(int bulletModelID) {
+	return getBulletModelUsersIndex().getUsers(bulletModelID);
+}
+
+AffectedLevelPackObjects LevelPack::getObjectsAffectedByBulletModel(int bulletModelID) {
+	AffectedLevelPackObjects affected;
+	for (int attackID : getBulletModelUsers(bulletModelID)) {
+		affected.attacks.insert(attackID);
+	}
+	addAttackUsers(affected);
+	return affected;
+}
+
+AffectedLevelPackObjects LevelPack::getObjectsAffectedByAttack(int attackID) {
+	AffectedLevelPackObjects affected;
+	affected.attacks.insert(attackID);
+	addAttackUsers(affected);
+	affected.attacks.erase(attackID);
+	return affected;
+}
+
+AffectedLevelPackObjects LevelPack::getObjectsAffectedByAttackPattern(int attackPatternID) {
+	AffectedLevelPackObjects affected;
+	affected.attackPatterns.insert(attackPatternID);
+	addAttackPatternUsers(affected);
+	affected.attackPatterns.erase(attackPatternID);
+	return affected;
+}
+
+AffectedLevelPackObjects LevelPack::getObjectsAffectedByEnemyPhase(int enemyPhaseID) {
+	AffectedLevelPackObjects affected;
+	affected.enemyPhases.insert(enemyPhaseID);
+	addEnemyPhaseUsers(affected);
+	affected.enemyPhases.erase(enemyPhaseID);
+	return affected;
+}
+
+AffectedLevelPackObjects LevelPack::getObjectsAffectedByEnemy(int enemyID) {
+	AffectedLevelPackObjects affected;
+	affected.enemies.insert(enemyID);
+	addEnemyUsers(affected);
+	affected.enemies.erase(enemyID);
+	return affected;
+}
+
+void LevelPack::addAttackUsers(AffectedLevelPackObjects& affected) {
+	for (int attackID : affected.attacks) {
+		for (int attackPatternID : getAttackUsers(attackID)) {
+			affected.attackPatterns.insert(attackPatternID);
 		}
 	}
-	return results;
+	addAttackPatternUsers(affected);
 }
 
-std::vector<int> LevelPack::getAttackUsers(int attackID) {
-	std::vector<int> results;
-	for (auto it = attackPatterns.begin(); it != attackPatterns.end(); it++) {
-		if (it->second->usesAttack(attackID)) {
-			results.push_back(it->first);
+void LevelPack::addAttackPatternUsers(AffectedLevelPackObjects& affected) {
+	for (int attackPatternID : affected.attackPatterns) {
+		for (int enemyPhaseID : getAttackPatternEnemyUsers(attackPatternID)) {
+			affected.enemyPhases.insert(enemyPhaseID);
+		}
+		if (attackPatternIsUsedByPlayer(attackPatternID)) {
+			affected.player = true;
 		}
 	}
-	return results;
+	addEnemyPhaseUsers(affected);
 }
 
-std::vector<int> LevelPack::getBulletModelUsers(int bulletModelID) {
-	std::vector<int> results;
-	for (auto it = attacks.begin(); it != attacks.end(); it++) {
-		if (it->second->usesBulletModel(bulletModelID)) {
-			results.push_back(it->first);
+void LevelPack::addEnemyPhaseUsers(AffectedLevelPackObjects& affected) {
+	for (int enemyPhaseID : affected.enemyPhases) {
+		for (int enemyID : getEditorEnemyUsers(enemyPhaseID)) {
+			affected.enemies.insert(enemyID);
 		}
 	}
-	return results;
+	addEnemyUsers(affected);
+}
+
+void LevelPack::addEnemyUsers(AffectedLevelPackObjects& affected) {
+	for (int enemyID : affected.enemies) {
+		for (int levelIndex : getEnemyUsers(enemyID)) {
+			affected.levels.insert(levelIndex);
+		}
+	}
+}
+
+ReverseDependencyIndex& LevelPack::getBulletModelUsersIndex() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	if (!bulletModelUsersIndex.isBuilt()) {
+		loadUnloadedAttacks();
+		for (auto p : attacks) {
+			bulletModelUsersIndex.setUses(p.first, p.second->getBulletModelIDCount());
+		}
+		bulletModelUsersIndex.setBuilt();
+	}
+	return bulletModelUsersIndex;
+}
+
+ReverseDependencyIndex& LevelPack::getAttackUsersIndex() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	if (!attackUsersIndex.isBuilt()) {
+		loadUnloadedObjects(attackPatterns, unloadedAttackPatterns, attackPatternsFileCache);
+		for (auto p : attackPatterns) {
+			attackUsersIndex.setUses(p.first, p.second->getAttackIDCount());
+		}
+		attackUsersIndex.setBuilt();
+	}
+	return attackUsersIndex;
+}
+
+ReverseDependencyIndex& LevelPack::getAttackPatternUsersIndex() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	if (!attackPatternUsersIndex.isBuilt()) {
+		loadUnloadedObjects(enemyPhases, unloadedEnemyPhases, enemyPhasesFileCache);
+		for (auto p : enemyPhases) {
+			attackPatternUsersIndex.setUses(p.first, p.second->getAttackPatternIDCount());
+		}
+		attackPatternUsersIndex.setBuilt();
+	}
+	return attackPatternUsersIndex;
+}
+
+ReverseDependencyIndex& LevelPack::getEnemyPhaseUsersIndex() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	if (!enemyPhaseUsersIndex.isBuilt()) {
+		loadUnloadedObjects(enemies, unloadedEnemies, enemiesFileCache);
+		for (auto p : enemies) {
+			enemyPhaseUsersIndex.setUses(p.first, p.second->getEnemyPhaseIDCount());
+		}
+		enemyPhaseUsersIndex.setBuilt();
+	}
+	return enemyPhaseUsersIndex;
+}
+
+/*
+Returns the number of EMPs on the longest path from emp to a leaf EMP.
+*/
+static int getTreeDepth(std::shared_ptr<EditorMovablePoint> emp) {
+	int childrenMax = 0;
+	for (auto child : emp->getChildren()) {
+		childrenMax = std::max(childrenMax, getTreeDepth(child));
+	}
+	return 1 + childrenMax;
+}
+
+/*
+Adds the file name of sound to soundFileNames if the sound can be played.
+*/
+static void addSoundFileName(const SoundSettings& sound, std::set<std::string>& soundFileNames) {
+	if (!sound.isDisabled() && sound.getFileName() != "") {
+		soundFileNames.insert(sound.getFileName());
+	}
+}
+
+/*
+Adds the file names of every sound played by emp or any of its children to soundFileNames.
+*/
+static void searchSoundFileNames(std::shared_ptr<EditorMovablePoint> emp, std::set<std::string>& soundFileNames) {
+	addSoundFileName(emp->getSoundSettings(), soundFileNames);
+	for (auto child : emp->getChildren()) {
+		searchSoundFileNames(child, soundFileNames);
+	}
+}
+
+const LevelProfile& LevelPack::getLevelProfile(std::shared_ptr<Level> level) {
+	std::size_t formatHash = std::hash<std::string>()(level->format() + "\n" + metadata.getPlayer()->format());
+	auto it = levelProfiles.find(level);
+	if (it != levelProfiles.end() && it->second.first == formatHash) {
+		return it->second.second;
+	}
+
+	LevelProfile profile;
+	std::set<int> enemyIDs;
+	std::set<int> attackPatternIDs;
+	std::set<int> attackIDs;
+	searchLevelDependencies(*level, enemyIDs, attackPatternIDs, attackIDs);
+
+	for (int attackID : attackIDs) {
+		std::shared_ptr<EditorMovablePoint> mainEMP = getAttack(attackID)->getMainEMP();
+		profile.largestBulletHitbox = std::max(profile.largestBulletHitbox, mainEMP->searchLargestHitbox());
+		profile.expectedPeakEntityCount += mainEMP->getTreeSize();
+		profile.maxAttachedTreeDepth = std::max(profile.maxAttachedTreeDepth, getTreeDepth(mainEMP));
+		searchSoundFileNames(mainEMP, profile.soundFileNames);
+	}
+	for (auto enemyIDCount : level->getEnemyIDCount()) {
+		profile.expectedPeakEntityCount += enemyIDCount.second;
+	}
+	for (int enemyID : enemyIDs) {
+		std::shared_ptr<EditorEnemy> enemy = getEnemy(enemyID);
+		addSoundFileName(enemy->getHurtSound(), profile.soundFileNames);
+		addSoundFileName(enemy->getDeathSound(), profile.soundFileNames);
+	}
+	std::shared_ptr<EditorPlayer> player = metadata.getPlayer();
+	addSoundFileName(player->getHurtSound(), profile.soundFileNames);
+	addSoundFileName(player->getDeathSound(), profile.soundFileNames);
+	addSoundFileName(player->getBombReadySound(), profile.soundFileNames);
+
+	std::vector<std::shared_ptr<Item>> items = { level->getHealthPack(), level->getPointsPack(), level->getPowerPack(), level->getBombItem() };
+	for (auto item : items) {
+		profile.largestItemActivationHitbox = std::max(profile.largestItemActivationHitbox, item->getActivationRadius());
+		profile.largestItemCollectionHitbox = std::max(profile.largestItemCollectionHitbox, item->getHitboxRadius());
+	}
+
+	levelProfiles[level] = std::make_pair(formatHash, profile);
+	return levelProfiles[level].second;
+}
+
+void LevelPack::searchLevelDependencies(const Level& level, std::set<int>& enemyIDs, std::set<int>& attackPatternIDs, std::set<int>& attackIDs) {
+	for (auto p : metadata.getPlayer()->getAttackPatternIDCount()) {
+		if (hasAttackPattern(p.first)) {
+			attackPatternIDs.insert(p.first);
+		}
+	}
+	for (auto enemyIDCount : level.getEnemyIDCount()) {
+		if (!hasEnemy(enemyIDCount.first)) continue;
+		enemyIDs.insert(enemyIDCount.first);
+		std::shared_ptr<EditorEnemy> enemy = getEnemy(enemyIDCount.first);
+		for (auto deathAction : enemy->getDeathActions()) {
+			if (auto executeAttacks = std::dynamic_pointer_cast<ExecuteAttacksDeathAction>(deathAction)) {
+				for (int attackID : executeAttacks->getAttackIDs()) {
+					if (hasAttack(attackID)) {
+						attackIDs.insert(attackID);
+					}
+				}
+			}
+		}
+		for (auto enemyPhaseIDCount : enemy->getEnemyPhaseIDCount()) {
+			if (!hasEnemyPhase(enemyPhaseIDCount.first)) continue;
+			for (auto attackPatternIDCount : getEnemyPhase(enemyPhaseIDCount.first)->getAttackPatternIDCount()) {
+				if (hasAttackPattern(attackPatternIDCount.first)) {
+					attackPatternIDs.insert(attackPatternIDCount.first);
+				}
+			}
+		}
+	}
+	for (int attackPatternID : attackPatternIDs) {
+		for (auto attackIDCount : getAttackPattern(attackPatternID)->getAttackIDCount()) {
+			if (hasAttack(attackIDCount.first)) {
+				attackIDs.insert(attackIDCount.first);
+			}
+		}
+	}
+}
+
+void LevelPack::clearLevelProfiles() {
+	levelProfiles.clear();
 }
 
 bool LevelPack::hasEnemy(int id) {
-	return enemies.count(id) != 0;
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	return enemies.count(id) != 0 || unloadedEnemies.count(id) != 0;
 }
 
 bool LevelPack::hasEnemyPhase(int id) {
-	return enemyPhases.count(id) != 0;
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	return enemyPhases.count(id) != 0 || unloadedEnemyPhases.count(id) != 0;
 }
 
 bool LevelPack::hasAttackPattern(int id) {
-	return attackPatterns.count(id) != 0;
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	return attackPatterns.count(id) != 0 || unloadedAttackPatterns.count(id) != 0;
 }
 
 bool LevelPack::hasAttack(int id) {
-	return attacks.count(id) != 0;
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	return attacks.count(id) != 0 || unloadedAttacks.count(id) != 0;
 }
 
 bool LevelPack::hasBulletModel(int id) {
@@ -593,19 +1040,35 @@ std::shared_ptr<Level> LevelPack::getLevel(int levelIndex) const {
 }
 
 std::shared_ptr<EditorAttack> LevelPack::getAttack(int id) const {
-	return attacks.at(id);
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	if (unloadedAttacks.count(id) == 0) {
+		return attacks.at(id);
+	}
+	std::shared_ptr<EditorAttack> attack = loadUnloadedObject(id, attacks, unloadedAttacks, attacksFileCache);
+	attack->loadEMPBulletModels(*this);
+	return attack;
+}
+
+void LevelPack::loadUnloadedAttacks() const {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	for (auto attack : loadUnloadedObjects(attacks, unloadedAttacks, attacksFileCache)) {
+		attack->loadEMPBulletModels(*this);
+	}
 }
 
 std::shared_ptr<EditorAttackPattern> LevelPack::getAttackPattern(int id) const {
-	return attackPatterns.at(id);
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	return loadUnloadedObject(id, attackPatterns, unloadedAttackPatterns, attackPatternsFileCache);
 }
 
 std::shared_ptr<EditorEnemy> LevelPack::getEnemy(int id) const {
-	return enemies.at(id);
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	return loadUnloadedObject(id, enemies, unloadedEnemies, enemiesFileCache);
 }
 
 std::shared_ptr<EditorEnemyPhase> LevelPack::getEnemyPhase(int id) const {
-	return enemyPhases.at(id);
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	return loadUnloadedObject(id, enemyPhases, unloadedEnemyPhases, enemyPhasesFileCache);
 }
 
 std::shared_ptr<BulletModel> LevelPack::getBulletModel(int id) const {
@@ -621,6 +1084,8 @@ std::string LevelPack::getFontFileName() {
 }
 
 std::map<int, std::shared_ptr<EditorAttack>>::iterator LevelPack::getAttackIteratorBegin() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	loadUnloadedAttacks();
 	return attacks.begin();
 }
 
@@ -629,6 +1094,8 @@ std::map<int, std::shared_ptr<EditorAttack>>::iterator LevelPack::getAttackItera
 }
 
 std::map<int, std::shared_ptr<EditorAttackPattern>>::iterator LevelPack::getAttackPatternIteratorBegin() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	loadUnloadedObjects(attackPatterns, unloadedAttackPatterns, attackPatternsFileCache);
 	return attackPatterns.begin();
 }
 
@@ -637,6 +1104,8 @@ std::map<int, std::shared_ptr<EditorAttackPattern>>::iterator LevelPack::getAtta
 }
 
 std::map<int, std::shared_ptr<EditorEnemy>>::iterator LevelPack::getEnemyIteratorBegin() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	loadUnloadedObjects(enemies, unloadedEnemies, enemiesFileCache);
 	return enemies.begin();
 }
 
@@ -645,6 +1114,8 @@ std::map<int, std::shared_ptr<EditorEnemy>>::iterator LevelPack::getEnemyIterato
 }
 
 std::map<int, std::shared_ptr<EditorEnemyPhase>>::iterator LevelPack::getEnemyPhaseIteratorBegin() {
+	std::lock_guard<std::recursive_mutex> lock(objectsMutex);
+	loadUnloadedObjects(enemyPhases, unloadedEnemyPhases, enemyPhasesFileCache);
 	return enemyPhases.begin();
 }
 
@@ -676,36 +1147,6 @@ void LevelPack::setPlayer(std::shared_ptr<EditorPlayer> player) {
 	onChange->publish();
 }
 
-float LevelPack::searchLargestBulletHitbox() const {
-	float max = 0;
-	for (auto p : attacks) {
-		max = std::max(max, p.second->searchLargestHitbox());
-	}
-	return max;
-}
-
-float LevelPack::searchLargestItemActivationHitbox() const {
-	float max = 0;
-	for (auto level : levels) {
-		max = std::max(max, level->getHealthPack()->getActivationRadius());
-		max = std::max(max, level->getPointsPack()->getActivationRadius());
-		max = std::max(max, level->getPowerPack()->getActivationRadius());
-		max = std::max(max, level->getBombItem()->getActivationRadius());
-	}
-	return max;
-}
-
-float LevelPack::searchLargestItemCollectionHitbox() const {
-	float max = 0;
-	for (auto level : levels) {
-		max = std::max(max, level->getHealthPack()->getHitboxRadius());
-		max = std::max(max, level->getPointsPack()->getHitboxRadius());
-		max = std::max(max, level->getPowerPack()->getHitboxRadius());
-		max = std::max(max, level->getBombItem()->getHitboxRadius());
-	}
-	return max;
-}
-
 void LevelPack::playSound(const SoundSettings & soundSettings) const {
 	if (soundSettings.getFileName() == "") return;
 	SoundSettings alteredPath = SoundSettings(soundSettings);
@@ -713,6 +1154,11 @@ void LevelPack::playSound(const SoundSettings & soundSettings) const {
 	audioPlayer.playSound(alteredPath);
 }
 
+void LevelPack::preloadSound(const std::string& fileName) const {
+	if (fileName == "") return;
+	audioPlayer.preloadSound("Level Packs/" + name + "/Sounds/" + fileName);
+}
+
 void LevelPack::playMusic(const MusicSettings & musicSettings) const {
 	if (musicSettings.getFileName() == "") return;
 	MusicSettings alteredPath = MusicSettings(musicSettings);
@@ -5,12 +5,17 @@
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <set>
+#include <future>
+#include <functional>
+#include <mutex>
 #include <SFML/Audio.hpp>
 #include "MovablePoint.h"
 #include "SpriteLoader.h"
 #include "TextMarshallable.h"
 #include "Components.h"
 #include "AudioPlayer.h"
+#include "LoadTimeReport.h"
 #include <entt/entt.hpp>
 
 class EditorAttack;
@@ -44,23 +49,244 @@ private:
 	std::vector<std::pair<std::string, std::string>> spriteSheets;
 };
 
+/*
+The serialized contents of a level pack object file as of the last load or save.
+Used so that saving only reformats objects that have changed and only rewrites files that have changed.
+
+Saving is split in two steps so that nothing is forgotten if the file can't be written: format() reformats
+every dirty object, then commit() is called once the file has or hasn't been written.
+*/
+class ObjectFileCache {
+public:
+	/*
+	Marks an object as created, updated, or deleted since the last save.
+	*/
+	inline void markDirty(int id) {
+		dirtyObjects.insert(id);
+		dirty = true;
+	}
+	/*
+	Replaces the cache with the contents of a file that was just loaded.
+
+	formattedObjects - maps object ID to the line in the file for that object
+	*/
+	inline void setLoaded(const std::map<int, std::string>& formattedObjects) {
+		this->formattedObjects = formattedObjects;
+		dirtyObjects.clear();
+		dirty = false;
+	}
+
+	/*
+	Reformats every dirty object without changing what the cache holds.
+	Returns true and sets fileContents to the new contents of the file if the file needs to be rewritten,
+	in which case commit() must be called once the file has been written or has failed to be written.
+	Objects marked dirty after this call stay dirty regardless of what is committed.
+	Objects with negative IDs are temporary and are never saved.
+
+	nextID - the next ID, which is always the first line of the file
+	objects - every object in the file, mapped by ID
+	*/
+	template<class T>
+	bool format(int nextID, const std::map<int, std::shared_ptr<T>>& objects, std::string& fileContents) {
+		if (!dirty) {
+			return false;
+		}
+
+		pendingFormattedObjects = formattedObjects;
+		for (int id : dirtyObjects) {
+			auto it = objects.find(id);
+			if (id >= 0 && it != objects.end()) {
+				pendingFormattedObjects[id] = it->second->format();
+			} else {
+				pendingFormattedObjects.erase(id);
+			}
+		}
+		pendingObjects = std::move(dirtyObjects);
+		dirtyObjects.clear();
+		dirty = false;
+
+		fileContents = std::to_string(nextID) + "\n";
+		for (auto& p : pendingFormattedObjects) {
+			fileContents += p.second + "\n";
+		}
+		return true;
+	}
+	/*
+	Finishes the last format() call.
+
+	written - whether the file contents from format() were written. If not, every object that was
+		reformatted is marked dirty again so that the next save tries again.
+	*/
+	inline void commit(bool written) {
+		if (written) {
+			formattedObjects = std::move(pendingFormattedObjects);
+		} else {
+			dirtyObjects.insert(pendingObjects.begin(), pendingObjects.end());
+			dirty = true;
+		}
+		pendingFormattedObjects.clear();
+		pendingObjects.clear();
+	}
+
+	/*
+	Returns the line an object was last loaded from or saved as.
+	*/
+	inline const std::string& getFormattedObject(int id) const { return formattedObjects.at(id); }
+
+private:
+	// Maps object ID to that object's format() as of the last load or save
+	std::map<int, std::string> formattedObjects;
+	// IDs of objects that have been created, updated, or deleted since the last save
+	std::set<int> dirtyObjects;
+	// Whether the file's contents may differ from what is on disk
+	bool dirty = true;
+	// formattedObjects as of the last format() call, which becomes formattedObjects once the file is written
+	std::map<int, std::string> pendingFormattedObjects;
+	// IDs of the objects that were dirty in the last format() call
+	std::set<int> pendingObjects;
+};
+
+/*
+Maps the ID of an object to the IDs of the objects that use it, for a single kind of relationship
+(for example, EditorAttackPatterns using EditorAttacks).
+An index is built the first time it is needed and is kept up to date from then on.
+*/
+class ReverseDependencyIndex {
+public:
+	inline bool isBuilt() const { return built; }
+	/*
+	Marks the index as built. Every user must have been added with setUses() beforehand.
+	*/
+	inline void setBuilt() { built = true; }
+	/*
+	Empties the index and marks it as not built.
+	*/
+	inline void clear() {
+		usedToUsers.clear();
+		userToUsed.clear();
+		built = false;
+	}
+
+	/*
+	Sets the objects used by the object with ID userID, replacing whatever it used before.
+
+	usedIDCount - maps the ID of each used object to the number of times it is used
+	*/
+	inline void setUses(int userID, const std::map<int, int>& usedIDCount) {
+		removeUser(userID);
+		std::set<int>& used = userToUsed[userID];
+		for (auto p : usedIDCount) {
+			if (p.second > 0) {
+				used.insert(p.first);
+				usedToUsers[p.first].insert(userID);
+			}
+		}
+	}
+	/*
+	Removes every relationship in which the object with ID userID is the user.
+	*/
+	inline void removeUser(int userID) {
+		auto it = userToUsed.find(userID);
+		if (it == userToUsed.end()) {
+			return;
+		}
+		for (int usedID : it->second) {
+			usedToUsers[usedID].erase(userID);
+			if (usedToUsers[usedID].empty()) {
+				usedToUsers.erase(usedID);
+			}
+		}
+		userToUsed.erase(it);
+	}
+
+	/*
+	Returns the IDs of the objects that use the object with ID usedID, in ascending order.
+	*/
+	inline std::vector<int> getUsers(int usedID) const {
+		auto it = usedToUsers.find(usedID);
+		if (it == usedToUsers.end()) {
+			return std::vector<int>();
+		}
+		return std::vector<int>(it->second.begin(), it->second.end());
+	}
+
+private:
+	// used object ID : IDs of objects that use it
+	std::map<int, std::set<int>> usedToUsers;
+	// user object ID : IDs of objects it uses
+	std::map<int, std::set<int>> userToUsed;
+	bool built = false;
+};
+
+/*
+Every object in a LevelPack that may behave differently when some other object changes.
+*/
+struct AffectedLevelPackObjects {
+	std::set<int> attacks;
+	std::set<int> attackPatterns;
+	std::set<int> enemyPhases;
+	std::set<int> enemies;
+	// Indices of Levels
+	std::set<int> levels;
+	// Whether the EditorPlayer is affected
+	bool player = false;
+};
+
+/*
+Data about a single Level that is used to size data structures and preload resources before the Level starts.
+Every EditorEnemy and EditorAttack that can appear in the Level, including those used by the EditorPlayer, is considered.
+*/
+struct LevelProfile {
+	// Radius of the largest bullet hitbox
+	float largestBulletHitbox = 0;
+	// Largest item activation radius
+	float largestItemActivationHitbox = 0;
+	// Largest item hitbox radius
+	float largestItemCollectionHitbox = 0;
+	// Estimate of the largest number of entities alive at once: every enemy spawn plus one of every EMP of every attack
+	int expectedPeakEntityCount = 0;
+	// Number of EMPs on the longest path from the main EMP of an attack to a leaf EMP
+	int maxAttachedTreeDepth = 0;
+	// File names of every sound that can be played
+	std::set<std::string> soundFileNames;
+};
+
 class LevelPack {
 public:
 	LevelPack(AudioPlayer& audioPlayer, std::string name);
+	~LevelPack();
 
 	/*
 	Load the LevelPack from its folder.
+	Every object file is read concurrently.
+	EditorAttacks, EditorAttackPatterns, EditorEnemies, and EditorEnemyPhases are only indexed by ID here;
+	each one is constructed the first time it is needed. See getLevelProfile().
 	*/
 	void load();
 	/*
 	Save the LevelPack into its folder.
+	Only objects that were created, updated, or deleted since the last load() or save() are reformatted,
+	and only files whose contents changed are rewritten. Each file is written to a temporary file first
+	and then renamed so that a file is never left half-written.
+
+	If a file can't be written, the objects in it are still considered changed, so the next save tries again.
+
+	inBackground - if true, the files are written on a separate thread and this function returns
+		as soon as every object has been formatted. Use waitForPendingSave() to wait for the writes to finish.
+	Returns false if a file could not be written. Always returns true if inBackground is true.
 	*/
-	void save();
+	bool save(bool inBackground = false);
+	/*
+	Blocks until the files from the last save(true) call have been written.
+	Returns false if any of them could not be written.
+	*/
+	bool waitForPendingSave();
 
 	/*
 	Creates the sprite loader that contains info for all animatables that are used in this level pack.
+	See the SpriteLoader constructor for createTextures.
 	*/
-	std::unique_ptr<SpriteLoader> createSpriteLoader();
+	std::unique_ptr<SpriteLoader> createSpriteLoader(bool createTextures = true);
 
 	/*
 	Insert a Level into this LevelPack at the specified index.
@@ -157,6 +383,39 @@ public:
 	*/
 	std::vector<int> getBulletModelUsers(int bulletModelID);
 
+	/*
+	Returns every object that directly or indirectly uses the BulletModel with ID bulletModelID,
+	following the same relationships as the get______Users() functions.
+	The BulletModel itself is not included.
+	*/
+	AffectedLevelPackObjects getObjectsAffectedByBulletModel(int bulletModelID);
+	/*
+	Returns every object that directly or indirectly uses the EditorAttack with ID attackID.
+	The EditorAttack itself is not included.
+	*/
+	AffectedLevelPackObjects getObjectsAffectedByAttack(int attackID);
+	/*
+	Returns every object that directly or indirectly uses the EditorAttackPattern with ID attackPatternID.
+	The EditorAttackPattern itself is not included.
+	*/
+	AffectedLevelPackObjects getObjectsAffectedByAttackPattern(int attackPatternID);
+	/*
+	Returns every object that directly or indirectly uses the EditorEnemyPhase with ID enemyPhaseID.
+	The EditorEnemyPhase itself is not included.
+	*/
+	AffectedLevelPackObjects getObjectsAffectedByEnemyPhase(int enemyPhaseID);
+	/*
+	Returns every Level that uses the EditorEnemy with ID enemyID.
+	*/
+	AffectedLevelPackObjects getObjectsAffectedByEnemy(int enemyID);
+
+	/*
+	Returns the LevelProfile of a Level, computing it if it has not been computed since the last change to this LevelPack
+	or since the Level or the EditorPlayer was last modified.
+	Every object used by the Level is constructed.
+	*/
+	const LevelProfile& getLevelProfile(std::shared_ptr<Level> level);
+
 	bool hasEnemy(int id);
 	bool hasEnemyPhase(int id);
 	bool hasAttackPattern(int id);
@@ -167,6 +426,7 @@ public:
 
 	std::string getName();
 	std::shared_ptr<Level> getLevel(int levelIndex) const;
+	// Objects are constructed on demand while objectsMutex is locked, so these can be called from any thread
 	std::shared_ptr<EditorAttack> getAttack(int id) const;
 	std::shared_ptr<EditorAttackPattern> getAttackPattern(int id) const;
 	std::shared_ptr<EditorEnemy> getEnemy(int id) const;
@@ -175,6 +435,8 @@ public:
 	std::shared_ptr<EditorPlayer> getPlayer();
 	std::string getFontFileName();
 
+	// Every object is constructed before the begin iterator is returned, but iterating is not guarded,
+	// so the maps must not be modified from another thread meanwhile
 	std::map<int, std::shared_ptr<EditorAttack>>::iterator getAttackIteratorBegin();
 	std::map<int, std::shared_ptr<EditorAttack>>::iterator getAttackIteratorEnd();
 	std::map<int, std::shared_ptr<EditorAttackPattern>>::iterator getAttackPatternIteratorBegin();
@@ -193,18 +455,20 @@ public:
 	int getNextBulletModelID() const { return nextBulletModelID; }
 
 	std::shared_ptr<entt::SigH<void()>> getOnChange();
+	/*
+	Returns the durations of each stage of the last load() call.
+	*/
+	inline const LoadTimeReport& getLoadTimeReport() const { return loadTimeReport; }
 
 	void setPlayer(std::shared_ptr<EditorPlayer> player);
 	void setFontFileName(std::string fontFileName) { this->fontFileName = fontFileName; }
 
-	// Returns the radius of the largest bullet in the level pack
-	float searchLargestBulletHitbox() const;
-	// Returns the radius of the largest item activation radius in the level pack
-	float searchLargestItemActivationHitbox() const;
-	// Returns the radius of the largest item hitbox radius in the level pack
-	float searchLargestItemCollectionHitbox() const;
-
 	void playSound(const SoundSettings& soundSettings) const;
+	/*
+	Loads a sound from this LevelPack's Sounds folder so that it does not have to be loaded the first time it is played.
+	fileName - same as a SoundSettings' file name
+	*/
+	void preloadSound(const std::string& fileName) const;
 	void playMusic(const MusicSettings& musicSettings) const;
 
 private:
@@ -224,19 +488,89 @@ private:
 	std::vector<std::shared_ptr<Level>> levels;
 	// The IDs of EditorAttack/EditorAttackPattern/EditorEnemy/EditorEnemyPhase are always positive, unless it is a temporary object.
 	// Temporary Editor_____ objects are deleted when deleteTemporaryEditorObjects() is called, and they cannot be saved in save().
+	// These are mutable because objects are constructed on demand in the const get______() functions.
+	// Editors use a LevelPack from more than one thread, so these, the unloaded______ sets, and the ObjectFileCaches
+	// are only accessed while objectsMutex is locked.
+	mutable std::recursive_mutex objectsMutex;
 	// attack id : attack
-	std::map<int, std::shared_ptr<EditorAttack>> attacks;
+	mutable std::map<int, std::shared_ptr<EditorAttack>> attacks;
 	// attack pattern id : attack pattern
-	std::map<int, std::shared_ptr<EditorAttackPattern>> attackPatterns;
+	mutable std::map<int, std::shared_ptr<EditorAttackPattern>> attackPatterns;
 	// enemy id : enemy
-	std::map<int, std::shared_ptr<EditorEnemy>> enemies;
+	mutable std::map<int, std::shared_ptr<EditorEnemy>> enemies;
 	// enemy phase id : enemy phase
-	std::map<int, std::shared_ptr<EditorEnemyPhase>> enemyPhases;
+	mutable std::map<int, std::shared_ptr<EditorEnemyPhase>> enemyPhases;
+	// IDs of objects that are in their file but have not been constructed yet.
+	// Their data is in the corresponding ObjectFileCache.
+	mutable std::set<int> unloadedAttacks;
+	mutable std::set<int> unloadedAttackPatterns;
+	mutable std::set<int> unloadedEnemies;
+	mutable std::set<int> unloadedEnemyPhases;
 	// bullet model id : bullet model
 	std::map<int, std::shared_ptr<BulletModel>> bulletModels;
 
 	std::string fontFileName = "font.ttf";
 
+	// Durations of each stage of the last load() call
+	LoadTimeReport loadTimeReport;
+
+	// Last saved contents of each file
+	std::string metafileCache;
+	std::string levelsFileCache;
+	ObjectFileCache bulletModelsFileCache;
+	ObjectFileCache attacksFileCache;
+	ObjectFileCache attackPatternsFileCache;
+	ObjectFileCache enemiesFileCache;
+	ObjectFileCache enemyPhasesFileCache;
+	// The file writes of the last save(true) call; whether each changed file was written, in order
+	std::future<std::vector<bool>> pendingSave;
+	// For each file being written by pendingSave, in the same order, updates its cache once it's known whether it was written
+	std::vector<std::function<void(bool)>> pendingSaveCommits;
+
+	// bullet model ID : IDs of EditorAttacks that use it
+	ReverseDependencyIndex bulletModelUsersIndex;
+	// attack ID : IDs of EditorAttackPatterns that use it
+	ReverseDependencyIndex attackUsersIndex;
+	// attack pattern ID : IDs of EditorEnemyPhases that use it
+	ReverseDependencyIndex attackPatternUsersIndex;
+	// enemy phase ID : IDs of EditorEnemies that use it
+	ReverseDependencyIndex enemyPhaseUsersIndex;
+
+	// Computed LevelProfiles, each paired with the hash of the formatted Level and EditorPlayer it was computed from.
+	// Levels and the player are modified in place without publishing onChange, so a profile is only reused if the hash still matches.
+	// Cleared whenever onChange is published.
+	std::map<std::shared_ptr<Level>, std::pair<std::size_t, LevelProfile>> levelProfiles;
+
+	/*
+	Constructs every EditorAttack that has not been constructed yet.
+	*/
+	void loadUnloadedAttacks() const;
+
+	/*
+	These return the corresponding ReverseDependencyIndex, building it first if it has not been built.
+	*/
+	ReverseDependencyIndex& getBulletModelUsersIndex();
+	ReverseDependencyIndex& getAttackUsersIndex();
+	ReverseDependencyIndex& getAttackPatternUsersIndex();
+	ReverseDependencyIndex& getEnemyPhaseUsersIndex();
+
+	/*
+	Adds every object that directly or indirectly uses any of the objects already in affected to affected.
+	Each function continues on to the next kind of user, so calling addAttackUsers() also adds
+	attack pattern users, enemy phase users, and so on.
+	*/
+	void addAttackUsers(AffectedLevelPackObjects& affected);
+	void addAttackPatternUsers(AffectedLevelPackObjects& affected);
+	void addEnemyPhaseUsers(AffectedLevelPackObjects& affected);
+	void addEnemyUsers(AffectedLevelPackObjects& affected);
+
+	/*
+	Finds the IDs of every EditorEnemy, EditorAttackPattern, and EditorAttack that can be used while playing a Level,
+	including those used by the EditorPlayer. IDs of objects that don't exist are not included.
+	*/
+	void searchLevelDependencies(const Level& level, std::set<int>& enemyIDs, std::set<int>& attackPatternIDs, std::set<int>& attackIDs);
+	void clearLevelProfiles();
+
 	// Called when a change is made to one of the level pack objects, which
 	// includes EditorAttack, EditorAttackPattern, EditorEnemy, EditorEnemyPhase,
 	// Level, BulletModel, and EditorPlayer.
@@ -0,0 +1,50 @@
+#include "LoadTimeReport.h"
+#include <boost/format.hpp>
+
+LoadTimeReport::LoadTimeReport(const LoadTimeReport & copy) {
+	std::lock_guard<std::mutex> lock(copy.stagesMutex);
+	stages = copy.stages;
+}
+
+LoadTimeReport & LoadTimeReport::operator=(const LoadTimeReport & other) {
+	if (this != &other) {
+		auto otherStages = other.getStages();
+		std::lock_guard<std::mutex> lock(stagesMutex);
+		stages = otherStages;
+	}
+	return *this;
+}
+
+void LoadTimeReport::clear() {
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	stages.clear();
+}
+
+void LoadTimeReport::addStage(std::string stageName, float seconds) {
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	stages.push_back(std::make_pair(stageName, seconds));
+}
+
+std::vector<std::pair<std::string, float>> LoadTimeReport::getStages() const {
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	return stages;
+}
+
+float LoadTimeReport::getStageTime(std::string stageName) const {
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	float total = 0;
+	for (auto p : stages) {
+		if (p.first == stageName) {
+			total += p.second;
+		}
+	}
+	return total;
+}
+
+std::string LoadTimeReport::toString() const {
+	std::string ret;
+	for (auto p : getStages()) {
+		ret += (boost::format("%-40s %8.2f ms\n") % p.first % (p.second * 1000.0f)).str();
+	}
+	return ret;
+}
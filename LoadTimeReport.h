@@ -0,0 +1,60 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <string>
+#include <vector>
+#include <utility>
+#include <mutex>
+
+/*
+Records how long each stage of a loading process took.
+Stages may be recorded from multiple threads at the same time.
+
+Stages that ran concurrently overlap, so the sum of all stage durations can be
+greater than the total time taken.
+*/
+class LoadTimeReport {
+public:
+	inline LoadTimeReport() {}
+	LoadTimeReport(const LoadTimeReport& copy);
+	LoadTimeReport& operator=(const LoadTimeReport& other);
+
+	void clear();
+	/*
+	Records a stage.
+
+	seconds - the amount of time the stage took
+	*/
+	void addStage(std::string stageName, float seconds);
+
+	/*
+	Returns pairs of stage name and the amount of time in seconds that stage took, in the order that the stages finished.
+	*/
+	std::vector<std::pair<std::string, float>> getStages() const;
+	/*
+	Returns the total amount of time in seconds taken by every stage named stageName.
+	*/
+	float getStageTime(std::string stageName) const;
+	/*
+	Returns a human-readable report with one line per stage.
+	*/
+	std::string toString() const;
+
+private:
+	mutable std::mutex stagesMutex;
+	std::vector<std::pair<std::string, float>> stages;
+};
+
+/*
+Adds a stage to a LoadTimeReport when it goes out of scope.
+The stage's duration is the lifetime of this object.
+*/
+class ScopedLoadStageTimer {
+public:
+	inline ScopedLoadStageTimer(LoadTimeReport& report, std::string stageName) : report(report), stageName(stageName) {}
+	inline ~ScopedLoadStageTimer() { report.addStage(stageName, clock.getElapsedTime().asSeconds()); }
+
+private:
+	LoadTimeReport& report;
+	std::string stageName;
+	sf::Clock clock;
+};
@@ -2,9 +2,94 @@
 #include <SFML/Graphics.hpp>
 #include "GameInstance.h"
 #include <iostream>
+#include <string>
+#include <vector>
 #include "EditorWindow.h"
+#include "ReplayImageRenderer.h"
+#include "SpatialHashBenchmark.h"
+#include "BloomComparison.h"
+
+/*
+Plays a replay headlessly and compares its last frame to a golden image, creating the golden image if it doesn't exist.
+Returns 0 if the images match or the golden image was created.
+*/
+static int runGoldenImageCheck(const std::string& levelPackName, const std::string& replayFileName, const std::string& goldenImageFileName, int tolerance) {
+	Replay replay;
+	if (!replay.loadFromFile(replayFileName)) {
+		std::cerr << "Could not load replay " << replayFileName << std::endl;
+		return 1;
+	}
+
+	ReplayImageRenderer renderer(levelPackName);
+	int differentPixels;
+	switch (renderer.compareToGoldenImage(replay, goldenImageFileName, differentPixels, tolerance)) {
+	case GOLDEN_IMAGE_MATCH:
+		std::cout << "Matches " << goldenImageFileName << std::endl;
+		return 0;
+	case GOLDEN_IMAGE_WRITTEN:
+		std::cout << "Created golden image " << goldenImageFileName << std::endl;
+		return 0;
+	case GOLDEN_IMAGE_DIFFERENT:
+		std::cerr << differentPixels << " pixels differ from " << goldenImageFileName << std::endl;
+		return 1;
+	case GOLDEN_IMAGE_SIZE_MISMATCH:
+		std::cerr << "Image is not the same size as " << goldenImageFileName << std::endl;
+		return 1;
+	case GOLDEN_IMAGE_WRITE_FAILED:
+	default:
+		std::cerr << "Could not create golden image " << goldenImageFileName << std::endl;
+		return 1;
+	}
+}
+
+/*
+Times the collision tables with a few bullet distributions and checks that they find the same collisions.
+Returns 0 if they always do.
+*/
+static int runSpatialHashBenchmark() {
+	// Pairs of large bullets count and large bullet radius, out of 5000 bullets
+	std::vector<std::pair<int, float>> cases = { { 0, 10 }, { 10, 100 }, { 1, 300 }, { 200, 60 } };
+	bool sameCollisions = true;
+	for (auto& c : cases) {
+		SpatialHashBenchmarkResult result = benchmarkSpatialHashTables(5000, c.first, c.second, 50, 200);
+		std::cout << "5000 bullets, " << c.first << " of radius " << c.second << ": fixed grids " << result.fixedGridsTime << "us/update ("
+			<< result.fixedGridsCandidates << " candidates), hierarchical " << result.hierarchicalTime << "us/update ("
+			<< result.hierarchicalCandidates << " candidates)" << (result.sameCollisions ? "" : ", COLLISIONS DIFFER") << std::endl;
+		sameCollisions = sameCollisions && result.sameCollisions;
+	}
+	return sameCollisions ? 0 : 1;
+}
+
+/*
+Draws the same frame at every bloom quality and prints how many pixels differ from full resolution bloom, and how long a frame takes.
+Returns 0 if no quality differs in more than maxDifferentFraction of the pixels.
+Needs a GPU, since bloom is drawn with shaders.
+*/
+static int runBloomComparison(int tolerance, float maxDifferentFraction) {
+	bool withinLimit = true;
+	for (BloomComparisonResult result : compareBloomQualities(tolerance, 60)) {
+		float differentFraction = (float)result.differentPixels / result.totalPixels;
+		std::cout << "Bloom quality " << result.quality << ": " << result.differentPixels << "/" << result.totalPixels << " pixels differ, "
+			<< result.frameTime << "ms/frame" << (differentFraction > maxDifferentFraction ? ", TOO DIFFERENT" : "") << std::endl;
+		withinLimit = withinLimit && differentFraction <= maxDifferentFraction;
+	}
+	return withinLimit ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+	// Usage: --golden-image <level pack name> <replay file> <golden image file> [tolerance]
+	if (argc >= 5 && std::string(argv[1]) == "--golden-image") {
+		return runGoldenImageCheck(argv[2], argv[3], argv[4], argc >= 6 ? std::stoi(argv[5]) : 0);
+	}
+	// Usage: --benchmark-spatial-hash
+	if (argc >= 2 && std::string(argv[1]) == "--benchmark-spatial-hash") {
+		return runSpatialHashBenchmark();
+	}
+	// Usage: --compare-bloom [tolerance] [max fraction of different pixels]
+	if (argc >= 2 && std::string(argv[1]) == "--compare-bloom") {
+		return runBloomComparison(argc >= 3 ? std::stoi(argv[2]) : 8, argc >= 4 ? std::stof(argv[3]) : 0.05f);
+	}
 
-int main() {
 	//GameInstance a("test pack");
 	//a.loadLevel(0);
 	//a.start();
@@ -21,4 +106,4 @@ int main() {
 
 	std::system("pause");
 	return 0;
-}
\ No newline at end of file
+}
@@ -38,12 +38,54 @@ public:
 		this->lifespan = lifespan;
 	}
 
+	/*
+	Returns a deep copy of this MP, including any state it has built up from being evaluated.
+	TFVs are shared with the copy since evaluating them never changes them.
+	*/
+	virtual std::shared_ptr<MovablePoint> clone() const = 0;
+
+	/*
+	Returns true if it can be proven that the MP stays outside of bounds at every time from time to its lifespan.
+	False only means that it could not be proven.
+
+	relativeTo - the position the MP is relative to; must not change during that time
+	time - 0 <= time <= lifespan
+	bounds - left and top are the minimum x and y
+	*/
+	virtual bool staysOutside(sf::Vector2f relativeTo, float time, const sf::FloatRect& bounds) { return false; }
+
 protected:
 	// Lifespan of the MP in seconds
 	// Only purpose is to make it known how long an MP SHOULD be alive; computing a position past an MP's lifespan should work
 	float lifespan;
 	bool returnGlobalPositions;
 
+	/*
+	Returns true if origin + s * direction is outside of bounds for every s in [minS, maxS].
+	*/
+	static bool segmentStaysOutside(sf::Vector2f origin, sf::Vector2f direction, float minS, float maxS, const sf::FloatRect& bounds) {
+		// Slab method; [enter, exit] is the range of s for which the line is inside bounds
+		float enter = -std::numeric_limits<float>::infinity();
+		float exit = std::numeric_limits<float>::infinity();
+		float origins[2] = { origin.x, origin.y };
+		float directions[2] = { direction.x, direction.y };
+		float lows[2] = { bounds.left, bounds.top };
+		float highs[2] = { bounds.left + bounds.width, bounds.top + bounds.height };
+		for (int axis = 0; axis < 2; axis++) {
+			if (directions[axis] == 0) {
+				if (origins[axis] < lows[axis] || origins[axis] > highs[axis]) {
+					return true;
+				}
+			} else {
+				float a = (lows[axis] - origins[axis]) / directions[axis];
+				float b = (highs[axis] - origins[axis]) / directions[axis];
+				enter = std::max(enter, std::min(a, b));
+				exit = std::min(exit, std::max(a, b));
+			}
+		}
+		return enter > exit || maxS < enter || minS > exit;
+	}
+
 private:
 	virtual sf::Vector2f evaluate(float time) = 0;
 };
@@ -72,6 +114,29 @@ public:
 		return mps[mps.size() - 1];
 	}
 
+	inline std::shared_ptr<MovablePoint> clone() const override {
+		std::vector<std::shared_ptr<MovablePoint>> mpsCopy;
+		for (std::shared_ptr<MovablePoint> mp : mps) {
+			mpsCopy.push_back(mp->clone());
+		}
+		return std::make_shared<AggregatorMP>(mpsCopy);
+	}
+
+	inline bool staysOutside(sf::Vector2f relativeTo, float time, const sf::FloatRect& bounds) override {
+		if (mps.size() == 0) {
+			return false;
+		}
+		for (int i = 0; i < mps.size(); i++) {
+			if (minTimes[i] + mps[i]->getLifespan() < time) {
+				continue;
+			}
+			if (!mps[i]->staysOutside(relativeTo, std::max(0.0f, time - minTimes[i]), bounds)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
 private:
 	std::vector<std::shared_ptr<MovablePoint>> mps;
 	// The minimum amount of time before reaching the MP; index of minTimes corresponds to index of mps
@@ -107,12 +172,20 @@ MP that always evaluates to an entity's position.
 */
 class EntityMP : public MovablePoint {
 public:
-	EntityMP(const PositionComponent& entityPosition, float lifespan) : MovablePoint(lifespan, false), entityPosition(entityPosition) {}
+	EntityMP(entt::DefaultRegistry& registry, uint32_t entity, float lifespan) : MovablePoint(lifespan, false), registry(registry), entity(entity) {}
+
+	inline std::shared_ptr<MovablePoint> clone() const override {
+		return std::make_shared<EntityMP>(*this);
+	}
 
 private:
-	const PositionComponent& entityPosition;
+	// The entity's PositionComponent is looked up on every evaluation rather than referenced directly,
+	// since component storage can be reallocated or restored from a RegistrySnapshot
+	entt::DefaultRegistry& registry;
+	uint32_t entity;
 
 	inline sf::Vector2f evaluate(float time) override {
+		auto& entityPosition = registry.get<PositionComponent>(entity);
 		return sf::Vector2f(entityPosition.getX(), entityPosition.getY());
 	}
 };
@@ -125,6 +198,14 @@ class StationaryMP : public MovablePoint {
 public:
 	inline StationaryMP(sf::Vector2f position, float lifespan) : MovablePoint(lifespan, false), position(position) {}
 
+	inline std::shared_ptr<MovablePoint> clone() const override {
+		return std::make_shared<StationaryMP>(*this);
+	}
+
+	inline bool staysOutside(sf::Vector2f relativeTo, float time, const sf::FloatRect& bounds) override {
+		return !bounds.contains(relativeTo + position);
+	}
+
 private:
 	sf::Vector2f position;
 
@@ -143,6 +224,29 @@ public:
 	*/
 	inline PolarMP(float lifespan, std::shared_ptr<TFV> distance, std::shared_ptr<TFV> angle) : MovablePoint(lifespan, false), angle(angle), distance(distance) {}
 
+	inline std::shared_ptr<MovablePoint> clone() const override {
+		return std::make_shared<PolarMP>(*this);
+	}
+
+	inline bool staysOutside(sf::Vector2f relativeTo, float time, const sf::FloatRect& bounds) override {
+		if (!distance->isNondecreasing(time, lifespan)) {
+			return false;
+		}
+		float minDistance = distance->evaluate(time);
+		if (angle->isConstant(time, lifespan)) {
+			// Moves outward along a ray from relativeTo
+			float a = angle->evaluate(time);
+			return segmentStaysOutside(relativeTo, sf::Vector2f(cos(a), sin(a)), minDistance, distance->evaluate(lifespan), bounds);
+		}
+		if (minDistance < 0) {
+			return false;
+		}
+		// The angle can be anything, so the MP must already be farther than every corner of bounds
+		float farthestX = std::max(std::abs(bounds.left - relativeTo.x), std::abs(bounds.left + bounds.width - relativeTo.x));
+		float farthestY = std::max(std::abs(bounds.top - relativeTo.y), std::abs(bounds.top + bounds.height - relativeTo.y));
+		return minDistance * minDistance > farthestX * farthestX + farthestY * farthestY;
+	}
+
 private:
 	std::shared_ptr<TFV> angle;
 	std::shared_ptr<TFV> distance;
@@ -164,6 +268,33 @@ public:
 	*/
 	inline BezierMP(float lifespan, std::vector<sf::Vector2f> controlPoints) : MovablePoint(lifespan, false), controlPoints(controlPoints), numControlPoints(controlPoints.size()) {}
 
+	inline std::shared_ptr<MovablePoint> clone() const override {
+		return std::make_shared<BezierMP>(*this);
+	}
+
+	inline bool staysOutside(sf::Vector2f relativeTo, float time, const sf::FloatRect& bounds) override {
+		// Split the curve with de Casteljau's algorithm; the remaining part of the curve is
+		// inside the bounding box of its own control points
+		if (numControlPoints == 0) {
+			return false;
+		}
+		float t = std::min(std::max(time / lifespan, 0.0f), 1.0f);
+		std::vector<sf::Vector2f> points = controlPoints;
+		sf::Vector2f low = points[numControlPoints - 1], high = points[numControlPoints - 1];
+		for (int level = numControlPoints - 1; level >= 0; level--) {
+			low.x = std::min(low.x, points[level].x);
+			low.y = std::min(low.y, points[level].y);
+			high.x = std::max(high.x, points[level].x);
+			high.y = std::max(high.y, points[level].y);
+			for (int i = 0; i < level; i++) {
+				points[i] = points[i] + t * (points[i + 1] - points[i]);
+			}
+		}
+		low += relativeTo;
+		high += relativeTo;
+		return high.x < bounds.left || low.x > bounds.left + bounds.width || high.y < bounds.top || low.y > bounds.top + bounds.height;
+	}
+
 private:
 	const std::vector<sf::Vector2f> controlPoints;
 	int numControlPoints;
@@ -217,6 +348,11 @@ public:
 
 	sf::Vector2f evaluate(float time) override;
 
+	inline std::shared_ptr<MovablePoint> clone() const override {
+		// Copies cachedPositions, lastEvaluatedTime, and prevAngle too
+		return std::make_shared<HomingMP>(*this);
+	}
+
 private:
 	struct CachedPositionSearchComparator {
 		int operator()(const std::pair<float, sf::Vector2f>& a, float b) {
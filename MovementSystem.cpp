@@ -2,31 +2,40 @@
 #include <cmath>
 
 void MovementSystem::update(float deltaTime) {
+	sf::FloatRect cullingBounds(-cullingMargin, -cullingMargin, MAP_WIDTH + 2 * cullingMargin, MAP_HEIGHT + 2 * cullingMargin);
+	retiredBulletsCount = 0;
+
 	auto view = registry.view<PositionComponent, MovementPathComponent>(entt::persistent_t{});
 	view.each([&](auto entity, auto& position, auto& path) {
-		float prevX = position.getX();
-		float prevY = position.getY();
+		position.savePreviousPosition();
 		path.update(queue, registry, entity, position, deltaTime);
-		// Calculate angle of movement
-		float angle = std::atan2(position.getY() - prevY, position.getX() - prevX);
+		if (cullingMargin >= 0 && !cullingBounds.contains(position.getX(), position.getY())) {
+			retireIfUnreachable(entity, position, path, cullingBounds);
+		}
+		// Entities that didn't move keep their last rotation, and entities that never rotate
+		// don't need their angle of movement calculated at all
+		float dx = position.getX() - position.getPreviousX();
+		float dy = position.getY() - position.getPreviousY();
 		if (registry.has<SpriteComponent>(entity)) {
 			// Rotate sprite
 			auto& sprite = registry.get<SpriteComponent>(entity);
-			sprite.rotate(angle);
+			sprite.rotateToMovement(dx, dy);
 
 			if (registry.has<HitboxComponent>(entity)) {
 				if (sprite.getSprite()) {
-					// Rotate hitbox according to sprite orientation
-					registry.get<HitboxComponent>(entity).rotate(sprite.getSprite());
+					// Rotate hitbox according to sprite orientation, which only changes when the sprite is updated
+					if (sprite.checkTransformChanged()) {
+						registry.get<HitboxComponent>(entity).rotate(sprite.getSprite());
+					}
 				} else {
-					// Rotate hitbox according to angle
-					registry.get<HitboxComponent>(entity).rotate(angle);
+					// Rotate hitbox according to movement
+					registry.get<HitboxComponent>(entity).rotateToMovement(dx, dy);
 				}
 			}
 		} else {
 			// Rotate hitbox
 			if (registry.has<HitboxComponent>(entity)) {
-				registry.get<HitboxComponent>(entity).rotate(angle);
+				registry.get<HitboxComponent>(entity).rotateToMovement(dx, dy);
 			}
 		}
 	});
@@ -36,3 +45,23 @@ void MovementSystem::update(float deltaTime) {
 		spawner.update(registry, spriteLoader, queue, deltaTime);
 	});
 }
+
+void MovementSystem::retireIfUnreachable(uint32_t entity, const PositionComponent& position, MovementPathComponent& path, const sf::FloatRect& cullingBounds) {
+	if (!registry.has<EnemyBulletComponent>(entity) && !registry.has<PlayerBulletComponent>(entity)) {
+		return;
+	}
+	// Bullets that will still spawn something or that have things attached to them can affect the play area from anywhere
+	if (registry.has<EMPSpawnerComponent>(entity) || !registry.has<DespawnComponent>(entity)) {
+		return;
+	}
+	auto& despawn = registry.get<DespawnComponent>(entity);
+	if (despawn.isMarkedForDespawn() || despawn.getChildren().size() > 0) {
+		return;
+	}
+
+	if (path.staysOutside(registry, position, cullingBounds)) {
+		despawn.removeEntityAttachment(registry, entity);
+		despawn.setMaxTime(0);
+		retiredBulletsCount++;
+	}
+}
@@ -13,8 +13,28 @@ public:
 	inline MovementSystem(EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry& registry) : queue(queue), spriteLoader(spriteLoader), registry(registry) {}
 	void update(float deltaTime);
 
+	/*
+	Sets how far outside the play area a bullet must be before it is checked for whether it can ever come back.
+	Bullets that provably can't are despawned early.
+
+	cullingMargin - negative if bullets should never be despawned early
+	*/
+	inline void setCullingMargin(float cullingMargin) { this->cullingMargin = cullingMargin; }
+	/*
+	Returns the number of bullets that were despawned early in the last update.
+	*/
+	inline int getRetiredBulletsCount() const { return retiredBulletsCount; }
+
 private:
 	EntityCreationQueue& queue;
 	SpriteLoader& spriteLoader;
 	entt::DefaultRegistry& registry;
+
+	float cullingMargin = -1;
+	int retiredBulletsCount = 0;
+
+	/*
+	Despawns the bullet if it can never come back within the culling margin.
+	*/
+	void retireIfUnreachable(uint32_t entity, const PositionComponent& position, MovementPathComponent& path, const sf::FloatRect& cullingBounds);
 };
\ No newline at end of file
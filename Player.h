@@ -76,6 +76,8 @@ public:
 	inline SoundSettings getBombReadySound() const { return bombReadySound; }
 	inline float getBombInvincibilityTime() const { return bombInvincibilityTime; }
 	inline bool usesAttackPattern(int attackPatternID) const { return attackPatternIDCount.count(attackPatternID) > 0 && attackPatternIDCount.at(attackPatternID) > 0; }
+	// Returns a map of the IDs of every EditorAttackPattern this player uses to the number of times it is used
+	inline const std::map<int, int>& getAttackPatternIDCount() const { return attackPatternIDCount; }
 
 	/*
 	Returns a reference to the power tier.
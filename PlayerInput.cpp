@@ -0,0 +1,125 @@
+#include "PlayerInput.h"
+#include <fstream>
+#include <cstring>
+
+// Identifies replay files
+static const char REPLAY_MAGIC[4] = { 'B', 'H', 'R', 'P' };
+static const uint32_t REPLAY_VERSION = 2;
+
+// Replay files are little-endian regardless of the host
+static void writeUint32(std::ostream& stream, uint32_t value) {
+	char bytes[4];
+	for (int i = 0; i < 4; i++) {
+		bytes[i] = (char)((value >> (i * 8)) & 0xFF);
+	}
+	stream.write(bytes, sizeof(bytes));
+}
+
+static void writeUint64(std::ostream& stream, uint64_t value) {
+	writeUint32(stream, (uint32_t)(value & 0xFFFFFFFF));
+	writeUint32(stream, (uint32_t)(value >> 32));
+}
+
+static void writeFloat(std::ostream& stream, float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	writeUint32(stream, bits);
+}
+
+static uint32_t readUint32(std::istream& stream) {
+	unsigned char bytes[4] = { 0, 0, 0, 0 };
+	stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+	uint32_t value = 0;
+	for (int i = 0; i < 4; i++) {
+		value |= (uint32_t)bytes[i] << (i * 8);
+	}
+	return value;
+}
+
+static uint64_t readUint64(std::istream& stream) {
+	uint64_t low = readUint32(stream);
+	uint64_t high = readUint32(stream);
+	return low | (high << 32);
+}
+
+static float readFloat(std::istream& stream) {
+	uint32_t bits = readUint32(stream);
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+void KeyboardInputSource::handleEvent(sf::Event event) {
+	if (paused) {
+		return;
+	}
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::X) {
+		bombPressed = true;
+	}
+}
+
+InputFrame KeyboardInputSource::poll() {
+	InputFrame input;
+	input.setPressed(INPUT_UP, sf::Keyboard::isKeyPressed(sf::Keyboard::Up));
+	input.setPressed(INPUT_DOWN, sf::Keyboard::isKeyPressed(sf::Keyboard::Down));
+	input.setPressed(INPUT_LEFT, sf::Keyboard::isKeyPressed(sf::Keyboard::Left));
+	input.setPressed(INPUT_RIGHT, sf::Keyboard::isKeyPressed(sf::Keyboard::Right));
+	input.setPressed(INPUT_FOCUS, sf::Keyboard::isKeyPressed(sf::Keyboard::LShift));
+	input.setPressed(INPUT_ATTACK, sf::Keyboard::isKeyPressed(sf::Keyboard::Z));
+	input.setPressed(INPUT_BOMB, bombPressed);
+	bombPressed = false;
+	return input;
+}
+
+bool Replay::saveToFile(const std::string& fileName) const {
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	file.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+	writeUint32(file, REPLAY_VERSION);
+	writeUint32(file, (uint32_t)levelIndex);
+	writeUint64(file, randomSeed);
+	writeUint32(file, (uint32_t)frames.size());
+	for (auto frame : frames) {
+		uint8_t bits = frame.second.getBits();
+		writeFloat(file, frame.first);
+		file.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+	}
+	return (bool)file;
+}
+
+bool Replay::loadFromFile(const std::string& fileName) {
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	char magic[sizeof(REPLAY_MAGIC)];
+	file.read(magic, sizeof(magic));
+	uint32_t version = readUint32(file);
+	int32_t level = (int32_t)readUint32(file);
+	uint64_t seed = readUint64(file);
+	uint32_t framesCount = readUint32(file);
+	if (!file || std::memcmp(magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 || version != REPLAY_VERSION) {
+		return false;
+	}
+
+	std::vector<std::pair<float, InputFrame>> loadedFrames;
+	loadedFrames.reserve(framesCount);
+	for (uint32_t i = 0; i < framesCount; i++) {
+		float deltaTime = readFloat(file);
+		uint8_t bits;
+		file.read(reinterpret_cast<char*>(&bits), sizeof(bits));
+		if (!file) {
+			return false;
+		}
+		loadedFrames.push_back(std::make_pair(deltaTime, InputFrame(bits)));
+	}
+
+	levelIndex = level;
+	randomSeed = seed;
+	frames = loadedFrames;
+	return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+A single player action. Each action is one bit in an InputFrame.
+*/
+enum PLAYER_INPUT {
+	INPUT_UP = 1 << 0,
+	INPUT_DOWN = 1 << 1,
+	INPUT_LEFT = 1 << 2,
+	INPUT_RIGHT = 1 << 3,
+	INPUT_FOCUS = 1 << 4,
+	INPUT_ATTACK = 1 << 5,
+	// The bomb key was pressed since the last InputFrame
+	INPUT_BOMB = 1 << 6
+};
+
+/*
+Everything the player is doing during a single physics update.
+*/
+class InputFrame {
+public:
+	inline InputFrame() {}
+	inline InputFrame(uint8_t bits) : bits(bits) {}
+
+	inline bool isPressed(PLAYER_INPUT input) const { return (bits & input) != 0; }
+	inline uint8_t getBits() const { return bits; }
+
+	inline void setPressed(PLAYER_INPUT input, bool pressed) {
+		if (pressed) {
+			bits |= input;
+		} else {
+			bits &= ~input;
+		}
+	}
+
+private:
+	uint8_t bits = 0;
+};
+
+/*
+Creates InputFrames from the keyboard.
+Key presses that only exist as events (bombs) are remembered until the next call to poll().
+While paused, those key presses are ignored so that they don't all go off as soon as the game resumes,
+and poll() should not be called.
+*/
+class KeyboardInputSource {
+public:
+	void handleEvent(sf::Event event);
+	/*
+	Returns the current state of the keyboard.
+	*/
+	InputFrame poll();
+
+	inline void setPaused(bool paused) { this->paused = paused; }
+
+private:
+	bool paused = false;
+	bool bombPressed = false;
+};
+
+/*
+The inputs of every physics update of a play session, which is enough to play the session again exactly.
+
+Replay files are binary, with every value little-endian:
+	4 bytes - "BHRP"
+	uint32 - file format version
+	int32 - level index
+	uint64 - random seed of the level
+	uint32 - number of frames
+	for each frame:
+		float32 - physics delta time, in seconds
+		uint8 - InputFrame bits
+*/
+class Replay {
+public:
+	inline Replay() {}
+	inline Replay(int levelIndex) : levelIndex(levelIndex) {}
+
+	/*
+	Returns false if the file could not be written.
+	*/
+	bool saveToFile(const std::string& fileName) const;
+	/*
+	Returns false if the file could not be read or is not a valid replay file.
+	*/
+	bool loadFromFile(const std::string& fileName);
+
+	inline void addFrame(float deltaTime, InputFrame input) { frames.push_back(std::make_pair(deltaTime, input)); }
+
+	inline int getLevelIndex() const { return levelIndex; }
+	inline uint64_t getRandomSeed() const { return randomSeed; }
+	inline int getFramesCount() const { return frames.size(); }
+	// Returns a pair of physics delta time and input
+	inline std::pair<float, InputFrame> getFrame(int index) const { return frames[index]; }
+
+	inline void setRandomSeed(uint64_t randomSeed) { this->randomSeed = randomSeed; }
+
+private:
+	int levelIndex = 0;
+	// The seed the level's RandomStreams were created with
+	uint64_t randomSeed = 0;
+	std::vector<std::pair<float, InputFrame>> frames;
+};
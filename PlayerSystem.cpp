@@ -1,7 +1,7 @@
 #include "PlayerSystem.h"
 #include "Constants.h"
 
-void PlayerSystem::update(float deltaTime) {
+void PlayerSystem::update(float deltaTime, InputFrame input) {
 	if (!registry.has<PlayerTag>()) {
 		return;
 	}
@@ -10,31 +10,27 @@ void PlayerSystem::update(float deltaTime) {
 
 	int verticalInput = 0;
 	int horizontalInput = 0;
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
+	if (input.isPressed(INPUT_UP)) {
 		verticalInput++;
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
+	if (input.isPressed(INPUT_DOWN)) {
 		verticalInput--;
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
+	if (input.isPressed(INPUT_LEFT)) {
 		horizontalInput--;
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
+	if (input.isPressed(INPUT_RIGHT)) {
 		horizontalInput++;
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)) {
-		playerTag.setFocused(true);
-	} else {
-		playerTag.setFocused(false);
-	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Z)) {
-		playerTag.setAttacking(true);
-	} else {
-		playerTag.setAttacking(false);
-	}
+	playerTag.setFocused(input.isPressed(INPUT_FOCUS));
+	playerTag.setAttacking(input.isPressed(INPUT_ATTACK));
 
 	uint32_t playerEntity = registry.attachee<PlayerTag>();
 
+	if (input.isPressed(INPUT_BOMB)) {
+		playerTag.activateBomb(registry, playerEntity);
+	}
+
 	if (playerTag.update(deltaTime, levelPack, queue, spriteLoader, registry, playerEntity) && playerTag.getBombCount() > 0) {
 		// Play bomb ready sound
 		levelPack.playSound(levelPack.getPlayer()->getBombReadySound());
@@ -74,14 +70,6 @@ void PlayerSystem::update(float deltaTime) {
 	}
 }
 
-void PlayerSystem::handleEvent(sf::Event event) {
-	if (event.type == sf::Event::KeyPressed) {
-		if (event.key.code == sf::Keyboard::X) {
-			registry.get<PlayerTag>().activateBomb(registry, registry.attachee<PlayerTag>());
-		}
-	}
-}
-
 void PlayerSystem::onResume() {
 	
 }
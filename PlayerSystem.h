@@ -8,6 +8,7 @@
 #include "SpriteLoader.h"
 #include "LevelPack.h"
 #include "AudioPlayer.h"
+#include "PlayerInput.h"
 
 /*
 Handles all things related to the player.
@@ -15,9 +16,11 @@ Handles all things related to the player.
 class PlayerSystem {
 public:
 	inline PlayerSystem(LevelPack& levelPack, EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry& registry) : levelPack(levelPack), queue(queue), spriteLoader(spriteLoader), registry(registry) {}
-	void update(float deltaTime);
+	/*
+	input - what the player is doing during this update
+	*/
+	void update(float deltaTime, InputFrame input);
 
-	void handleEvent(sf::Event event);
 	void onResume();
 
 private:
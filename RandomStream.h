@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+
+/*
+A small and fast pseudo-random number generator (PCG32).
+Streams created with the same seed and stream ID always produce the same sequence on every platform,
+so anything randomized with them plays out the same way every time a replay is played.
+*/
+class RandomStream {
+public:
+	/*
+	seed - the seed shared by every stream in a level
+	streamID - identifies this stream among all streams with the same seed; streams with different IDs are independent
+	*/
+	inline RandomStream(uint64_t seed, uint64_t streamID) : state(0), increment((streamID << 1) | 1) {
+		nextUInt();
+		state += seed;
+		nextUInt();
+	}
+
+	/*
+	Returns a uniformly distributed number in the range [0, 2^32).
+	*/
+	inline uint32_t nextUInt() {
+		uint64_t oldState = state;
+		state = oldState * 6364136223846793005ULL + increment;
+		uint32_t xorShifted = (uint32_t)(((oldState >> 18) ^ oldState) >> 27);
+		uint32_t rotation = (uint32_t)(oldState >> 59);
+		return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+	}
+
+	/*
+	Returns a uniformly distributed float in the range [min, max).
+	*/
+	inline float nextFloat(float min, float max) {
+		// 24 random bits is the most a float can represent uniformly in [0, 1)
+		return min + (nextUInt() >> 8) * (1.0f / 16777216.0f) * (max - min);
+	}
+
+	/*
+	Returns a uniformly distributed int in the range [min, max].
+	*/
+	inline int nextInt(int min, int max) {
+		uint64_t range = (uint64_t)((int64_t)max - min) + 1;
+		return (int)(min + (int64_t)((nextUInt() * range) >> 32));
+	}
+
+private:
+	uint64_t state;
+	// Must be odd
+	uint64_t increment;
+};
@@ -0,0 +1,95 @@
+#include "RegistrySnapshot.h"
+#include <cassert>
+#include "EntityCreationQueue.h"
+
+/*
+Archive that entt's Snapshot writes entity IDs into.
+*/
+class EntityOutputArchive {
+public:
+	inline EntityOutputArchive(std::vector<uint32_t>& buffer) : buffer(buffer) {}
+
+	inline void operator()(uint32_t value) {
+		buffer.push_back(value);
+	}
+
+private:
+	std::vector<uint32_t>& buffer;
+};
+
+/*
+Archive that entt's SnapshotLoader reads entity IDs from, in the same order they were written.
+*/
+class EntityInputArchive {
+public:
+	inline EntityInputArchive(const std::vector<uint32_t>& buffer) : buffer(buffer) {}
+
+	inline void operator()(uint32_t& value) {
+		value = buffer[index++];
+	}
+
+private:
+	const std::vector<uint32_t>& buffer;
+	int index = 0;
+};
+
+RegistrySnapshot::RegistrySnapshot(entt::DefaultRegistry& registry, const EntityCreationQueue& queue) : entityCount(registry.alive()) {
+	assert(queue.isEmpty() && "Queued entity creations cannot be captured in a RegistrySnapshot");
+
+	EntityOutputArchive out(entities);
+	registry.snapshot().entities(out).destroyed(out);
+
+	captureComponents(registry, positionComponents);
+	captureComponents(registry, movementPathComponents);
+	captureComponents(registry, healthComponents);
+	captureComponents(registry, hitboxComponents);
+	captureComponents(registry, spriteComponents);
+	captureComponents(registry, enemyComponents);
+	captureComponents(registry, despawnComponents);
+	captureComponents(registry, enemyBulletComponents);
+	captureComponents(registry, playerBulletComponents);
+	captureComponents(registry, simpleEMPReferenceComponents);
+	captureComponents(registry, empSpawnerComponents);
+	captureComponents(registry, shadowTrailComponents);
+	captureComponents(registry, animatableSetComponents);
+	captureComponents(registry, collectibleComponents);
+	captureTag(registry, playerTag);
+	captureTag(registry, levelManagerTag);
+
+	// Copying a MovementPathComponent shares its paths, so separate them from the live ones,
+	// which will continue to be modified as the game runs
+	for (auto& p : movementPathComponents) {
+		p.second.deepCopyPaths();
+	}
+}
+
+void RegistrySnapshot::restore(entt::DefaultRegistry& registry) const {
+	// entt can only restore entities into a registry that has never had any,
+	// so replace the registry in place; references to the registry itself stay valid
+	registry = entt::DefaultRegistry{};
+
+	EntityInputArchive in(entities);
+	registry.restore().entities(in).destroyed(in);
+
+	restoreComponents(registry, positionComponents);
+	restoreComponents(registry, movementPathComponents);
+	restoreComponents(registry, healthComponents);
+	restoreComponents(registry, hitboxComponents);
+	restoreComponents(registry, spriteComponents);
+	restoreComponents(registry, enemyComponents);
+	restoreComponents(registry, despawnComponents);
+	restoreComponents(registry, enemyBulletComponents);
+	restoreComponents(registry, playerBulletComponents);
+	restoreComponents(registry, simpleEMPReferenceComponents);
+	restoreComponents(registry, empSpawnerComponents);
+	restoreComponents(registry, shadowTrailComponents);
+	restoreComponents(registry, animatableSetComponents);
+	restoreComponents(registry, collectibleComponents);
+	restoreTag(registry, playerTag);
+	restoreTag(registry, levelManagerTag);
+
+	// Same as in the constructor, but so that the snapshot's paths are never modified
+	registry.view<MovementPathComponent>().each([](auto entity, MovementPathComponent& movementPath) {
+		movementPath.deepCopyPaths();
+	});
+}
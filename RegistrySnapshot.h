@@ -0,0 +1,95 @@
+#pragma once
+#include <entt/entt.hpp>
+#include <vector>
+#include <utility>
+#include "Components.h"
+
+class EntityCreationQueue;
+
+/*
+A copy of every entity and component in a registry at some point in time.
+Restoring a snapshot puts the registry back into exactly that state, so a level can be jumped
+to some point without simulating everything before it.
+
+Each component type is copied into its own contiguous vector. MovablePoints, sprites, and animations
+are deep copied since they change as the game runs. Level pack objects (EMPs, attack patterns, enemies, etc.),
+their TFVs, and signals are shared with the live components rather than copied, since they are never modified
+by the game.
+*/
+class RegistrySnapshot {
+public:
+	/*
+	Takes a snapshot of the registry.
+
+	queue - the registry's entity creation queue; must be empty, which it always is between physics updates
+	*/
+	RegistrySnapshot(entt::DefaultRegistry& registry, const EntityCreationQueue& queue);
+
+	/*
+	Replaces everything in the registry with the contents of this snapshot.
+	Entities keep the IDs they had when the snapshot was taken. The snapshot itself is not changed, so it can be restored any number of times.
+	Any references to components in the registry are invalidated, but since signals are shared, anything connected to
+	a component's signal before the snapshot was taken stays connected.
+	*/
+	void restore(entt::DefaultRegistry& registry) const;
+
+	/*
+	Returns the number of entities that were alive when the snapshot was taken.
+	*/
+	inline int getEntityCount() const { return entityCount; }
+
+private:
+	int entityCount;
+	// Entity IDs and versions as written by entt's snapshot; includes destroyed entities so that
+	// entities created after a restore get the same IDs as they would have without the restore
+	std::vector<uint32_t> entities;
+
+	std::vector<std::pair<uint32_t, PositionComponent>> positionComponents;
+	std::vector<std::pair<uint32_t, MovementPathComponent>> movementPathComponents;
+	std::vector<std::pair<uint32_t, HealthComponent>> healthComponents;
+	std::vector<std::pair<uint32_t, HitboxComponent>> hitboxComponents;
+	std::vector<std::pair<uint32_t, SpriteComponent>> spriteComponents;
+	std::vector<std::pair<uint32_t, EnemyComponent>> enemyComponents;
+	std::vector<std::pair<uint32_t, DespawnComponent>> despawnComponents;
+	std::vector<std::pair<uint32_t, EnemyBulletComponent>> enemyBulletComponents;
+	std::vector<std::pair<uint32_t, PlayerBulletComponent>> playerBulletComponents;
+	std::vector<std::pair<uint32_t, SimpleEMPReferenceComponent>> simpleEMPReferenceComponents;
+	std::vector<std::pair<uint32_t, EMPSpawnerComponent>> empSpawnerComponents;
+	std::vector<std::pair<uint32_t, ShadowTrailComponent>> shadowTrailComponents;
+	std::vector<std::pair<uint32_t, AnimatableSetComponent>> animatableSetComponents;
+	std::vector<std::pair<uint32_t, CollectibleComponent>> collectibleComponents;
+	// Tags; each has at most one element
+	std::vector<std::pair<uint32_t, PlayerTag>> playerTag;
+	std::vector<std::pair<uint32_t, LevelManagerTag>> levelManagerTag;
+
+	template<class T>
+	static void captureComponents(entt::DefaultRegistry& registry, std::vector<std::pair<uint32_t, T>>& components) {
+		auto view = registry.view<T>();
+		components.reserve(view.size());
+		for (auto entity : view) {
+			components.emplace_back(entity, registry.get<T>(entity));
+		}
+	}
+
+	template<class T>
+	static void restoreComponents(entt::DefaultRegistry& registry, const std::vector<std::pair<uint32_t, T>>& components) {
+		registry.reserve<T>(components.size());
+		for (auto& p : components) {
+			registry.assign<T>(p.first, p.second);
+		}
+	}
+
+	template<class T>
+	static void captureTag(entt::DefaultRegistry& registry, std::vector<std::pair<uint32_t, T>>& tag) {
+		if (registry.has<T>()) {
+			tag.emplace_back(registry.attachee<T>(), registry.get<T>());
+		}
+	}
+
+	template<class T>
+	static void restoreTag(entt::DefaultRegistry& registry, const std::vector<std::pair<uint32_t, T>>& tag) {
+		for (auto& p : tag) {
+			registry.assign<T>(entt::tag_t{}, p.first, p.second);
+		}
+	}
+};
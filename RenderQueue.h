@@ -0,0 +1,185 @@
+#pragma once
+#include "Components.h"
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+/*
+The sprites to be drawn in a frame, sorted by layer, then sublayer, then texture.
+
+Each sprite is given a 64-bit draw key, so sorting only moves small keys around instead of dereferencing
+the sprites' components. Sprites in the same sublayer are grouped by texture (sprites with shaders last)
+so that drawing them switches textures as rarely as possible.
+
+All buffers are reused across frames.
+*/
+class RenderQueue {
+public:
+	inline void clear() {
+		keys.clear();
+		sprites.clear();
+	}
+
+	inline void push(SpriteComponent& sprite) {
+		DrawKey drawKey;
+		drawKey.key = (uint64_t(sprite.getRenderLayer() & 0xFF) << 56) | (uint64_t(getSortableBits(sprite.getSubLayer())) << 24)
+			| (uint64_t(sprite.usesShader() ? 1 : 0) << 23) | getTextureID(sprite.getSprite()->getTexture());
+		drawKey.index = (uint32_t)sprites.size();
+		keys.push_back(drawKey);
+		sprites.push_back(&sprite);
+	}
+
+	/*
+	Sorts the sprites pushed since the last clear().
+	*/
+	inline void sort() {
+		std::size_t count = keys.size();
+
+		// Sprites are pushed in mostly the same order every frame, so last frame's sorted order
+		// is usually already sorted or close to it
+		tempKeys.clear();
+		for (uint32_t index : previousOrder) {
+			if (index < count) {
+				tempKeys.push_back(keys[index]);
+			}
+		}
+		for (std::size_t i = previousOrder.size(); i < count; i++) {
+			tempKeys.push_back(keys[i]);
+		}
+		keys.swap(tempKeys);
+
+		std::size_t descents = 0;
+		for (std::size_t i = 1; i < count; i++) {
+			if (keys[i].key < keys[i - 1].key) {
+				descents++;
+			}
+		}
+		if (descents > 0) {
+			if (descents * NEARLY_SORTED_RATIO <= count) {
+				insertionSort();
+			} else {
+				radixSort();
+			}
+		}
+
+		previousOrder.resize(count);
+		for (std::size_t i = 0; i < count; i++) {
+			previousOrder[i] = keys[i].index;
+		}
+	}
+
+	inline std::size_t size() const { return keys.size(); }
+	/*
+	Returns the sprite at some position in sorted order.
+	*/
+	inline SpriteComponent& getSprite(std::size_t i) const { return *sprites[keys[i].index]; }
+	/*
+	Returns the layer of the sprite at some position in sorted order.
+	*/
+	inline int getLayer(std::size_t i) const { return (int)(keys[i].key >> 56); }
+	/*
+	Returns the position of the first sprite in a different layer from the sprite at position begin,
+	or size() if there is none.
+	*/
+	inline std::size_t getLayerEnd(std::size_t begin) const {
+		int layer = getLayer(begin);
+		std::size_t end = begin + 1;
+		while (end < keys.size() && getLayer(end) == layer) {
+			end++;
+		}
+		return end;
+	}
+
+private:
+	struct DrawKey {
+		// From most to least significant bits: layer (8), sublayer (32), uses shader (1), texture ID (23)
+		uint64_t key;
+		// Index in sprites
+		uint32_t index;
+	};
+
+	// Insertion sort is used instead of radix sort if there is at most 1 out-of-order pair of keys per this many keys
+	static const std::size_t NEARLY_SORTED_RATIO = 64;
+	static const uint32_t MAX_TEXTURE_ID = (1 << 23) - 1;
+
+	std::vector<DrawKey> keys;
+	std::vector<DrawKey> tempKeys;
+	std::vector<SpriteComponent*> sprites;
+	// The indices of the keys in sorted order in the last sort()
+	std::vector<uint32_t> previousOrder;
+	// Maps a texture to an ID used in draw keys
+	std::unordered_map<const sf::Texture*, uint32_t> textureIDs;
+
+	/*
+	Returns bits of a float that sort in the same order as the float when compared as an unsigned int.
+	*/
+	static inline uint32_t getSortableBits(float value) {
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+	}
+
+	inline uint32_t getTextureID(const sf::Texture* texture) {
+		auto it = textureIDs.find(texture);
+		if (it != textureIDs.end()) {
+			return it->second;
+		}
+		// IDs only affect grouping, so they can all be reassigned if they run out
+		if (textureIDs.size() > MAX_TEXTURE_ID) {
+			textureIDs.clear();
+		}
+		uint32_t id = (uint32_t)textureIDs.size();
+		textureIDs[texture] = id;
+		return id;
+	}
+
+	inline void insertionSort() {
+		for (std::size_t i = 1; i < keys.size(); i++) {
+			DrawKey drawKey = keys[i];
+			std::size_t j = i;
+			while (j > 0 && keys[j - 1].key > drawKey.key) {
+				keys[j] = keys[j - 1];
+				j--;
+			}
+			keys[j] = drawKey;
+		}
+	}
+
+	/*
+	Least significant digit radix sort, one byte at a time.
+	Bytes that are the same in every key (such as the layer byte, most of the time) are skipped.
+	*/
+	inline void radixSort() {
+		std::size_t count = keys.size();
+		tempKeys.resize(count);
+
+		std::size_t counts[8][256];
+		std::memset(counts, 0, sizeof(counts));
+		for (const DrawKey& drawKey : keys) {
+			for (int pass = 0; pass < 8; pass++) {
+				counts[pass][(drawKey.key >> (pass * 8)) & 0xFF]++;
+			}
+		}
+
+		for (int pass = 0; pass < 8; pass++) {
+			std::size_t* passCounts = counts[pass];
+			if (passCounts[(keys[0].key >> (pass * 8)) & 0xFF] == count) {
+				continue;
+			}
+
+			std::size_t offset = 0;
+			for (int digit = 0; digit < 256; digit++) {
+				std::size_t digitCount = passCounts[digit];
+				passCounts[digit] = offset;
+				offset += digitCount;
+			}
+			for (const DrawKey& drawKey : keys) {
+				tempKeys[passCounts[(drawKey.key >> (pass * 8)) & 0xFF]++] = drawKey;
+			}
+			keys.swap(tempKeys);
+		}
+	}
+};
@@ -0,0 +1,42 @@
+#include "RenderSnapshot.h"
+#include <cmath>
+
+void RenderBatches::build(const RenderSnapshot& snapshot) {
+	vertices.clear();
+	batches.clear();
+
+	for (const SpriteSnapshot& sprite : snapshot.getSprites()) {
+		bool startsNewBatch = batches.empty() || sprite.effectAnimation || batches.back().effectAnimation
+			|| batches.back().layer != sprite.layer || batches.back().texture != sprite.texture;
+		if (startsNewBatch) {
+			RenderBatch batch;
+			batch.layer = sprite.layer;
+			batch.texture = sprite.texture;
+			batch.effectAnimation = sprite.effectAnimation;
+			batch.vertexStart = vertices.size();
+			batch.vertexCount = 0;
+			batches.push_back(batch);
+		}
+
+		// Same corners as sf::Sprite
+		float width = (float)std::abs(sprite.textureRect.width);
+		float height = (float)std::abs(sprite.textureRect.height);
+		float left = (float)sprite.textureRect.left;
+		float right = left + sprite.textureRect.width;
+		float top = (float)sprite.textureRect.top;
+		float bottom = top + sprite.textureRect.height;
+
+		sf::Vertex topLeft(sprite.transform.transformPoint(0, 0), sprite.color, sf::Vector2f(left, top));
+		sf::Vertex bottomLeft(sprite.transform.transformPoint(0, height), sprite.color, sf::Vector2f(left, bottom));
+		sf::Vertex topRight(sprite.transform.transformPoint(width, 0), sprite.color, sf::Vector2f(right, top));
+		sf::Vertex bottomRight(sprite.transform.transformPoint(width, height), sprite.color, sf::Vector2f(right, bottom));
+
+		vertices.push_back(topLeft);
+		vertices.push_back(bottomLeft);
+		vertices.push_back(topRight);
+		vertices.push_back(topRight);
+		vertices.push_back(bottomLeft);
+		vertices.push_back(bottomRight);
+		batches.back().vertexCount += 6;
+	}
+}
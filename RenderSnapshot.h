@@ -0,0 +1,76 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+
+class SpriteEffectAnimation;
+
+/*
+Everything needed to draw a sprite, copied out of its SpriteComponent.
+*/
+struct SpriteSnapshot {
+	int layer;
+	sf::Transform transform;
+	// Owned by the SpriteLoader
+	const sf::Texture* texture;
+	sf::IntRect textureRect;
+	sf::Color color;
+	// Only set if the sprite is drawn with its effect animation's shader
+	// Shared so that the shader outlives the sprite's entity until it is drawn
+	std::shared_ptr<SpriteEffectAnimation> effectAnimation;
+};
+
+/*
+An immutable copy of every sprite to be drawn in a frame, in the order they are drawn.
+Nothing in it refers to the registry, so it can be read from any thread.
+*/
+class RenderSnapshot {
+public:
+	inline void clear() { sprites.clear(); }
+	inline void push(SpriteSnapshot sprite) { sprites.push_back(std::move(sprite)); }
+	inline const std::vector<SpriteSnapshot>& getSprites() const { return sprites; }
+
+private:
+	std::vector<SpriteSnapshot> sprites;
+};
+
+/*
+A range of vertices that can be drawn with a single draw call.
+*/
+struct RenderBatch {
+	int layer;
+	const sf::Texture* texture;
+	// nullptr if the batch is drawn without a shader
+	std::shared_ptr<SpriteEffectAnimation> effectAnimation;
+	std::size_t vertexStart;
+	std::size_t vertexCount;
+};
+
+/*
+The vertices of every sprite in a RenderSnapshot, as sf::Triangles, and the batches they are drawn in.
+Consecutive sprites in the same layer with the same texture and no shader are merged into one batch.
+*/
+class RenderBatches {
+public:
+	/*
+	Replaces the batches with the ones for a snapshot.
+	Does not touch the GPU, so it can be called from any thread, as long as the batches were cleared
+	beforehand on the thread that draws them. Otherwise, clearing them here could destroy a shader.
+	*/
+	void build(const RenderSnapshot& snapshot);
+	/*
+	Removes every batch and vertex.
+	Must be called from the thread that draws, since the batches may hold the last reference to a shader.
+	*/
+	inline void clear() {
+		vertices.clear();
+		batches.clear();
+	}
+
+	inline const std::vector<sf::Vertex>& getVertices() const { return vertices; }
+	inline const std::vector<RenderBatch>& getBatches() const { return batches; }
+
+private:
+	std::vector<sf::Vertex> vertices;
+	std::vector<RenderBatch> batches;
+};
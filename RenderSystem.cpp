@@ -4,18 +4,8 @@
 #include <cmath>
 #include "Level.h"
 
-RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow & window, SpriteLoader& spriteLoader, float resolutionMultiplier, bool initShaders) : registry(registry), window(window), resolutionMultiplier(resolutionMultiplier) {
-	// Initialize layers to be size of the max layer
-	layers = std::vector<std::pair<int, std::vector<std::reference_wrapper<SpriteComponent>>>>(HIGHEST_RENDER_LAYER + 1);
-	layers[SHADOW_LAYER] = std::make_pair(SHADOW_LAYER, std::vector<std::reference_wrapper<SpriteComponent>>());
-	layers[PLAYER_BULLET_LAYER] = std::make_pair(PLAYER_BULLET_LAYER, std::vector<std::reference_wrapper<SpriteComponent>>());
-	layers[ENEMY_LAYER] = std::make_pair(ENEMY_LAYER, std::vector<std::reference_wrapper<SpriteComponent>>());
-	layers[ENEMY_BOSS_LAYER] = std::make_pair(ENEMY_BOSS_LAYER, std::vector<std::reference_wrapper<SpriteComponent>>());
-	layers[PLAYER_LAYER] = std::make_pair(PLAYER_LAYER, std::vector<std::reference_wrapper<SpriteComponent>>());
-	layers[ITEM_LAYER] = std::make_pair(ITEM_LAYER, std::vector<std::reference_wrapper<SpriteComponent>>());
-	layers[ENEMY_BULLET_LAYER] = std::make_pair(ENEMY_BULLET_LAYER, std::vector<std::reference_wrapper<SpriteComponent>>());
-
-	setResolution(spriteLoader, resolutionMultiplier);
+RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow & window, float resolutionMultiplier, bool initShaders) : registry(registry), window(window), resolutionMultiplier(resolutionMultiplier) {
+	setResolution(resolutionMultiplier);
 
 	// Initialize global shaders
 	if (initShaders) {
@@ -26,7 +16,7 @@ RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow &
 				throw "Could not load Shaders/gaussian_blur.frag";
 			}
 			shadowBlurHorizontal->setUniform("texture", sf::Shader::CurrentTexture);
-			shadowBlurHorizontal->setUniform("resolution", sf::Vector2f(layerTextures[SHADOW_LAYER].getSize().x, layerTextures[SHADOW_LAYER].getSize().y));
+			shadowBlurHorizontal->setUniform("resolution", sf::Vector2f(getResolution().x, getResolution().y));
 			shadowBlurHorizontal->setUniform("direction", sf::Vector2f(1, 0));
 			shadowBlurHorizontal->setUniform("mode", 0);
 			globalShaders[SHADOW_LAYER].push_back(std::move(shadowBlurHorizontal));
@@ -36,7 +26,7 @@ RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow &
 				throw "Could not load Shaders/gaussian_blur.frag";
 			}
 			shadowBlurVertical->setUniform("texture", sf::Shader::CurrentTexture);
-			shadowBlurVertical->setUniform("resolution", sf::Vector2f(layerTextures[SHADOW_LAYER].getSize().x, layerTextures[SHADOW_LAYER].getSize().y));
+			shadowBlurVertical->setUniform("resolution", sf::Vector2f(getResolution().x, getResolution().y));
 			shadowBlurVertical->setUniform("direction", sf::Vector2f(0, 1));
 			shadowBlurVertical->setUniform("mode", 0);
 			globalShaders[SHADOW_LAYER].push_back(std::move(shadowBlurVertical));
@@ -49,7 +39,7 @@ RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow &
 				throw "Could not load Shaders/n_linear_blur.frag";
 			}
 			blurHorizontal->setUniform("texture", sf::Shader::CurrentTexture);
-			blurHorizontal->setUniform("resolution", sf::Vector2f(layerTextures[SHADOW_LAYER].getSize().x, layerTextures[SHADOW_LAYER].getSize().y));
+			blurHorizontal->setUniform("resolution", sf::Vector2f(getResolution().x, getResolution().y));
 			blurHorizontal->setUniform("direction", sf::Vector2f(1, 0));
 			blurHorizontal->setUniform("n", 15);
 			bloomBlurShaders.push_back(std::move(blurHorizontal));
@@ -59,10 +49,20 @@ RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow &
 				throw "Could not load Shaders/n_linear_blur.frag";
 			}
 			blurVertical->setUniform("texture", sf::Shader::CurrentTexture);
-			blurVertical->setUniform("resolution", sf::Vector2f(layerTextures[SHADOW_LAYER].getSize().x, layerTextures[SHADOW_LAYER].getSize().y));
+			blurVertical->setUniform("resolution", sf::Vector2f(getResolution().x, getResolution().y));
 			blurVertical->setUniform("direction", sf::Vector2f(0, 1));
 			blurVertical->setUniform("n", 15);
 			bloomBlurShaders.push_back(std::move(blurVertical));
+
+			for (sf::Vector2f direction : { sf::Vector2f(1, 0), sf::Vector2f(0, 1) }) {
+				std::unique_ptr<sf::Shader> pyramidBlur = std::make_unique<sf::Shader>();
+				if (!pyramidBlur->loadFromFile("Shaders/n_linear_blur.frag", sf::Shader::Fragment)) {
+					throw "Could not load Shaders/n_linear_blur.frag";
+				}
+				pyramidBlur->setUniform("texture", sf::Shader::CurrentTexture);
+				pyramidBlur->setUniform("direction", direction);
+				bloomPyramidBlurShaders.push_back(std::move(pyramidBlur));
+			}
 		}
 
 		// Bloom bright shader
@@ -80,62 +80,94 @@ RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow &
 }
 
 void RenderSystem::update(float deltaTime) {
-	for (int i = 0; i < layers.size(); i++) {
-		layers[i].second.clear();
-		layerTextures[i].clear(sf::Color::Transparent);
-	}
+	takeSnapshot(updateSnapshot);
+	updateBatches.build(updateSnapshot);
+	draw(updateBatches, deltaTime);
+}
+
+void RenderSystem::takeSnapshot(RenderSnapshot& snapshot) {
+	renderQueue.clear();
+
+	// Sprites completely outside the play area would never be seen
+	sf::FloatRect playArea(0, -MAP_HEIGHT, MAP_WIDTH, MAP_HEIGHT);
+	culledSpritesCount = 0;
 
 	auto view = registry.view<PositionComponent, SpriteComponent>(entt::persistent_t{});
 	view.each([&](auto entity, auto& position, auto& sprite) {
 		if (sprite.getSprite()) {
-			sprite.getSprite()->setPosition(position.getX() * resolutionMultiplier, -position.getY() * resolutionMultiplier);
-			layers[sprite.getRenderLayer()].second.push_back(std::ref(sprite));
+			sprite.getSprite()->setPosition(position.getX(), -position.getY());
+			if (!playArea.intersects(sprite.getSprite()->getGlobalBounds())) {
+				culledSpritesCount++;
+				return;
+			}
+			renderQueue.push(sprite);
 		}
 	});
-
-	for (std::pair<int, std::vector<std::reference_wrapper<SpriteComponent>>>& pair : layers) {
-		std::sort(pair.second.begin(), pair.second.end(), SubLayerComparator());
+	renderQueue.sort();
+
+	snapshot.clear();
+	for (std::size_t i = 0; i < renderQueue.size(); i++) {
+		SpriteComponent& sprite = renderQueue.getSprite(i);
+		const sf::Sprite& spriteToDraw = *sprite.getSprite();
+
+		SpriteSnapshot spriteSnapshot;
+		spriteSnapshot.layer = renderQueue.getLayer(i);
+		spriteSnapshot.transform = spriteToDraw.getTransform();
+		spriteSnapshot.texture = spriteToDraw.getTexture();
+		spriteSnapshot.textureRect = spriteToDraw.getTextureRect();
+		spriteSnapshot.color = spriteToDraw.getColor();
+		if (sprite.usesShader()) {
+			spriteSnapshot.effectAnimation = sprite.getEffectAnimation();
+		}
+		snapshot.push(std::move(spriteSnapshot));
 	}
+}
 
+void RenderSystem::draw(const RenderBatches& batches, float deltaTime) {
 	// Move background
 	backgroundX = std::fmod((backgroundX + backgroundScrollSpeedX * deltaTime), backgroundTextureSizeX);
 	backgroundY = std::fmod((backgroundY + backgroundScrollSpeedY * deltaTime), backgroundTextureSizeY);
 	backgroundSprite.setTextureRect(sf::IntRect(backgroundX, backgroundY, backgroundTextureWidth, backgroundTextureHeight));
 
-	// Draw background by drawing onto the temp layer first to limit the visible part of the background to the play area
-	tempLayerTexture.clear(sf::Color::Transparent);
-
-	backgroundSprite.setPosition(0, -MAP_HEIGHT * resolutionMultiplier);
-	tempLayerTexture.draw(backgroundSprite);
-	tempLayerTexture.display();
-	sf::Sprite backgroundAsSprite(tempLayerTexture.getTexture());
-	sf::RenderStates backgroundStates;
+	// The background sprite is exactly the size of the play area, so it can be drawn directly onto the window
+	backgroundSprite.setPosition(0, -MAP_HEIGHT);
+	sf::RenderStates backgroundStates(layerToWindowTransform);
 	backgroundStates.blendMode = DEFAULT_BLEND_MODE;
-	window.draw(backgroundAsSprite, backgroundStates);
-
-	for (int i = 0; i < layers.size(); i++) {
-		for (SpriteComponent& sprite : layers[i].second) {
-			std::shared_ptr<sf::Sprite> spritePtr = sprite.getSprite();
+	window.draw(backgroundSprite, backgroundStates);
+
+	const std::vector<RenderBatch>& layerBatches = batches.getBatches();
+	// Each iteration draws every batch in one layer; empty layers have no batches
+	for (std::size_t begin = 0, end; begin < layerBatches.size(); begin = end) {
+		int i = layerBatches[begin].layer;
+		end = begin + 1;
+		while (end < layerBatches.size() && layerBatches[end].layer == i) {
+			end++;
+		}
 
-			if (sprite.usesShader()) {
-				layerTextures[i].draw(*spritePtr, &sprite.getShader());
-			}
-			else {
-				layerTextures[i].draw(*spritePtr);
+		if (!usesPostProcessing(i)) {
+			// Nothing is applied to the layer as a whole, so its sprites don't need to go through a layer texture
+			for (std::size_t k = begin; k < end; k++) {
+				drawBatch(window, batches, layerBatches[k], layerToWindowTransform);
 			}
-		}
-		if (layers[i].second.size() == 0) {
 			continue;
 		}
-		layerTextures[i].display();
+
+		sf::RenderTexture& layerTexture = getLayerTexture(i);
+		layerTexture.clear(sf::Color::Transparent);
+		for (std::size_t k = begin; k < end; k++) {
+			drawBatch(layerTexture, batches, layerBatches[k], sf::Transform::Identity);
+		}
+		layerTexture.display();
 
 		if (bloom[i].usesBloom()) {
-			if (globalShaders.count(i) > 0) {
+			if (bloom[i].getQuality() != BLOOM_FULL_RESOLUTION) {
+				drawPyramidBloom(globalShaders.count(i) > 0 ? applyGlobalShaders(i) : layerTexture, bloom[i]);
+			} else if (globalShaders.count(i) > 0) {
 				bool alt = false;
 				for (int a = 0; a < globalShaders[i].size(); a++) {
 					alt = !alt;
 					if (alt) {
-						sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+						sf::Sprite textureAsSprite(layerTexture.getTexture());
 						// idk why this is needed but it is
 						textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
@@ -151,12 +183,12 @@ void RenderSystem::update(float deltaTime) {
 						// idk why this is needed but it is
 						textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
-						layerTextures[i].clear(sf::Color::Transparent);
+						layerTexture.clear(sf::Color::Transparent);
 						sf::RenderStates states;
 						states.shader = &(*globalShaders[i][a]);
 						states.blendMode = DEFAULT_BLEND_MODE;
-						layerTextures[i].draw(textureAsSprite, states);
-						layerTextures[i].display();
+						layerTexture.draw(textureAsSprite, states);
+						layerTexture.display();
 					}
 				}
 
@@ -180,7 +212,7 @@ void RenderSystem::update(float deltaTime) {
 
 						alt = !alt;
 						if (alt) {
-							sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+							sf::Sprite textureAsSprite(layerTexture.getTexture());
 							// idk why this is needed but it is
 							textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
@@ -196,12 +228,12 @@ void RenderSystem::update(float deltaTime) {
 							// idk why this is needed but it is
 							textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
-							layerTextures[i].clear(sf::Color::Transparent);
+							layerTexture.clear(sf::Color::Transparent);
 							sf::RenderStates states;
 							states.shader = shader;
 							states.blendMode = mode;
-							layerTextures[i].draw(textureAsSprite, states);
-							layerTextures[i].display();
+							layerTexture.draw(textureAsSprite, states);
+							layerTexture.display();
 						}
 					}
 
@@ -214,7 +246,7 @@ void RenderSystem::update(float deltaTime) {
 						window.draw(textureAsSprite, states);
 					}
 					else {
-						sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+						sf::Sprite textureAsSprite(layerTexture.getTexture());
 
 						sf::RenderStates states;
 						states.shader = &bloomGlowShader;
@@ -229,7 +261,7 @@ void RenderSystem::update(float deltaTime) {
 					window.draw(textureAsSprite2, states);
 				}
 				else {
-					sf::Texture nonblurredTexture = sf::Texture(layerTextures[i].getTexture());
+					sf::Texture nonblurredTexture = sf::Texture(layerTexture.getTexture());
 					bloomGlowShader.setUniform("strength", bloom[i].getGlowStrength());
 
 					// Apply blur shaders
@@ -248,7 +280,7 @@ void RenderSystem::update(float deltaTime) {
 
 						alt = !alt;
 						if (alt) {
-							sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+							sf::Sprite textureAsSprite(layerTexture.getTexture());
 							// idk why this is needed but it is
 							textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
@@ -264,12 +296,12 @@ void RenderSystem::update(float deltaTime) {
 							// idk why this is needed but it is
 							textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
-							layerTextures[i].clear(sf::Color::Transparent);
+							layerTexture.clear(sf::Color::Transparent);
 							sf::RenderStates states;
 							states.shader = shader;
 							states.blendMode = mode;
-							layerTextures[i].draw(textureAsSprite, states);
-							layerTextures[i].display();
+							layerTexture.draw(textureAsSprite, states);
+							layerTexture.display();
 						}
 					}
 
@@ -282,7 +314,7 @@ void RenderSystem::update(float deltaTime) {
 						window.draw(textureAsSprite, states);
 					}
 					else {
-						sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+						sf::Sprite textureAsSprite(layerTexture.getTexture());
 
 						sf::RenderStates states;
 						states.shader = &bloomGlowShader;
@@ -298,7 +330,7 @@ void RenderSystem::update(float deltaTime) {
 				}
 			}
 			else {
-				sf::Texture nonblurredTexture = sf::Texture(layerTextures[i].getTexture());
+				sf::Texture nonblurredTexture = sf::Texture(layerTexture.getTexture());
 				bloomGlowShader.setUniform("strength", bloom[i].getGlowStrength());
 
 				// Apply blur shaders
@@ -317,7 +349,7 @@ void RenderSystem::update(float deltaTime) {
 
 					alt = !alt;
 					if (alt) {
-						sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+						sf::Sprite textureAsSprite(layerTexture.getTexture());
 						// idk why this is needed but it is
 						textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
@@ -333,12 +365,12 @@ void RenderSystem::update(float deltaTime) {
 						// idk why this is needed but it is
 						textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
-						layerTextures[i].clear(sf::Color::Transparent);
+						layerTexture.clear(sf::Color::Transparent);
 						sf::RenderStates states;
 						states.shader = shader;
 						states.blendMode = mode;
-						layerTextures[i].draw(textureAsSprite, states);
-						layerTextures[i].display();
+						layerTexture.draw(textureAsSprite, states);
+						layerTexture.display();
 					}
 				}
 
@@ -352,7 +384,7 @@ void RenderSystem::update(float deltaTime) {
 					window.draw(textureAsSprite, states);
 				}
 				else {
-					sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+					sf::Sprite textureAsSprite(layerTexture.getTexture());
 
 					sf::RenderStates states;
 					states.shader = &bloomGlowShader;
@@ -368,87 +400,80 @@ void RenderSystem::update(float deltaTime) {
 			}
 		}
 		else {
-			if (globalShaders.count(i) > 0) {
-				if (globalShaders[i].size() == 1) {
-					sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+			// Only global shaders
+			if (globalShaders[i].size() == 1) {
+				sf::Sprite textureAsSprite(layerTexture.getTexture());
 
-					sf::RenderStates states;
-					states.shader = &(*globalShaders[i][0]);
-					states.blendMode = DEFAULT_BLEND_MODE;
-					window.draw(textureAsSprite, states);
-				}
-				else {
-					bool alt = false;
-					for (int a = 0; a < globalShaders[i].size(); a++) {
-						alt = !alt;
-						if (alt) {
-							sf::Sprite textureAsSprite(layerTextures[i].getTexture());
-							// idk why this is needed but it is
-							textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
-
-							tempLayerTexture.clear(sf::Color::Transparent);
-							sf::RenderStates states;
-							states.shader = &(*globalShaders[i][a]);
-							states.blendMode = DEFAULT_BLEND_MODE;
-							tempLayerTexture.draw(textureAsSprite, states);
-							tempLayerTexture.display();
-						}
-						else {
-							sf::Sprite textureAsSprite(tempLayerTexture.getTexture());
-							// idk why this is needed but it is
-							textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
-
-							layerTextures[i].clear(sf::Color::Transparent);
-							sf::RenderStates states;
-							states.shader = &(*globalShaders[i][a]);
-							states.blendMode = DEFAULT_BLEND_MODE;
-							layerTextures[i].draw(textureAsSprite, states);
-							layerTextures[i].display();
-						}
-					}
+				sf::RenderStates states;
+				states.shader = &(*globalShaders[i][0]);
+				states.blendMode = DEFAULT_BLEND_MODE;
+				window.draw(textureAsSprite, states);
+			}
+			else {
+				bool alt = false;
+				for (int a = 0; a < globalShaders[i].size(); a++) {
+					alt = !alt;
 					if (alt) {
-						sf::Sprite textureAsSprite(tempLayerTexture.getTexture());
-						window.draw(textureAsSprite);
+						sf::Sprite textureAsSprite(layerTexture.getTexture());
+						// idk why this is needed but it is
+						textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
+
+						tempLayerTexture.clear(sf::Color::Transparent);
+						sf::RenderStates states;
+						states.shader = &(*globalShaders[i][a]);
+						states.blendMode = DEFAULT_BLEND_MODE;
+						tempLayerTexture.draw(textureAsSprite, states);
+						tempLayerTexture.display();
 					}
 					else {
-						sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+						sf::Sprite textureAsSprite(tempLayerTexture.getTexture());
+						// idk why this is needed but it is
+						textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
 
+						layerTexture.clear(sf::Color::Transparent);
 						sf::RenderStates states;
+						states.shader = &(*globalShaders[i][a]);
 						states.blendMode = DEFAULT_BLEND_MODE;
-						window.draw(textureAsSprite, states);
+						layerTexture.draw(textureAsSprite, states);
+						layerTexture.display();
 					}
 				}
-			}
-			else {
-				sf::Sprite textureAsSprite(layerTextures[i].getTexture());
+				if (alt) {
+					sf::Sprite textureAsSprite(tempLayerTexture.getTexture());
+					window.draw(textureAsSprite);
+				}
+				else {
+					sf::Sprite textureAsSprite(layerTexture.getTexture());
 
-				sf::RenderStates states;
-				states.blendMode = DEFAULT_BLEND_MODE;
-				window.draw(textureAsSprite, states);
+					sf::RenderStates states;
+					states.blendMode = DEFAULT_BLEND_MODE;
+					window.draw(textureAsSprite, states);
+				}
 			}
 		}
 	}
 }
 
-void RenderSystem::setResolution(SpriteLoader& spriteLoader, float resolutionMultiplier) {
-	spriteLoader.setGlobalSpriteScale(resolutionMultiplier);
+void RenderSystem::setResolution(float resolutionMultiplier) {
+	this->resolutionMultiplier = resolutionMultiplier;
 
 	int newPlayAreaWidth = (int)std::round(MAP_WIDTH * resolutionMultiplier);
 	int newPlayAreaHeight = (int)std::round(MAP_HEIGHT * resolutionMultiplier);
 
-	sf::View view(sf::FloatRect(0, -newPlayAreaHeight, newPlayAreaWidth, newPlayAreaHeight));
-	for (int i = 0; i < HIGHEST_RENDER_LAYER + 1; i++) {
-		layerTextures[i].create(newPlayAreaWidth, newPlayAreaHeight);
-		layerTextures[i].setView(view);
-	}
+	// Layer textures see the play area in map units, so the view does all the scaling to the resolution
+	sf::View view(sf::FloatRect(0, -MAP_HEIGHT, MAP_WIDTH, MAP_HEIGHT));
+	// Layer textures are recreated at the new resolution when they are next needed
+	layerTextures.clear();
 	tempLayerTexture.create(newPlayAreaWidth, newPlayAreaHeight);
 	tempLayerTexture.setView(view);
-	tempLayerTexture2.create(newPlayAreaWidth, newPlayAreaHeight);
-	tempLayerTexture2.setView(view);
+	layerToWindowTransform = sf::Transform().scale((float)newPlayAreaWidth / MAP_WIDTH, (float)newPlayAreaHeight / MAP_HEIGHT).translate(0, MAP_HEIGHT);
 
 	spriteHorizontalScale = view.getSize().x / tempLayerTexture.getSize().x;
 	spriteVerticalScale = view.getSize().y / tempLayerTexture.getSize().y;
 
+	bloomPyramid.clear();
+	bloomPyramidTemp.clear();
+
 	for (auto it = globalShaders.begin(); it != globalShaders.end(); it++) {
 		for (auto& shader : it->second) {
 			shader->setUniform("resolution", sf::Vector2f(newPlayAreaWidth, newPlayAreaHeight));
@@ -458,13 +483,151 @@ void RenderSystem::setResolution(SpriteLoader& spriteLoader, float resolutionMul
 		shader->setUniform("resolution", sf::Vector2f(newPlayAreaWidth, newPlayAreaHeight));
 	}
 
-	backgroundSprite.setScale(MAP_WIDTH / backgroundTextureWidth * resolutionMultiplier, MAP_HEIGHT / backgroundTextureHeight * resolutionMultiplier);
-
 	if (onResolutionChange) {
 		onResolutionChange->publish();
 	}
 }
 
+sf::RenderTexture& RenderSystem::applyGlobalShaders(int layer) {
+	bool alt = false;
+	for (int a = 0; a < globalShaders[layer].size(); a++) {
+		alt = !alt;
+		sf::RenderTexture& source = alt ? getLayerTexture(layer) : tempLayerTexture;
+		sf::RenderTexture& dest = alt ? tempLayerTexture : getLayerTexture(layer);
+
+		sf::Sprite textureAsSprite(source.getTexture());
+		// idk why this is needed but it is
+		textureAsSprite.setScale(spriteHorizontalScale, spriteVerticalScale);
+
+		dest.clear(sf::Color::Transparent);
+		sf::RenderStates states;
+		states.shader = &(*globalShaders[layer][a]);
+		states.blendMode = DEFAULT_BLEND_MODE;
+		dest.draw(textureAsSprite, states);
+		dest.display();
+	}
+	return alt ? tempLayerTexture : getLayerTexture(layer);
+}
+
+void RenderSystem::drawBatch(sf::RenderTarget& target, const RenderBatches& batches, const RenderBatch& batch, const sf::Transform& transform) {
+	sf::RenderStates states(transform);
+	states.texture = batch.texture;
+	if (batch.effectAnimation) {
+		states.shader = &batch.effectAnimation->getShader();
+	}
+	target.draw(&batches.getVertices()[batch.vertexStart], batch.vertexCount, sf::Triangles, states);
+}
+
+sf::RenderTexture& RenderSystem::getLayerTexture(int layer) {
+	auto it = layerTextures.find(layer);
+	if (it != layerTextures.end()) {
+		return it->second;
+	}
+	sf::RenderTexture& layerTexture = layerTextures[layer];
+	layerTexture.create(tempLayerTexture.getSize().x, tempLayerTexture.getSize().y);
+	layerTexture.setView(tempLayerTexture.getView());
+	return layerTexture;
+}
+
+bool RenderSystem::usesPostProcessing(int layer) {
+	return globalShaders.count(layer) > 0 || bloom[layer].usesBloom();
+}
+
+void RenderSystem::createBloomPyramid(int levels) {
+	sf::Vector2u size = getResolution();
+	while (bloomPyramid.size() < levels) {
+		int divisor = 2 << bloomPyramid.size();
+		unsigned int width = std::max(1u, size.x / divisor);
+		unsigned int height = std::max(1u, size.y / divisor);
+
+		std::unique_ptr<sf::RenderTexture> texture = std::make_unique<sf::RenderTexture>();
+		texture->create(width, height);
+		// Smoothing makes downsampling and upsampling bilinear
+		texture->setSmooth(true);
+		bloomPyramid.push_back(std::move(texture));
+
+		std::unique_ptr<sf::RenderTexture> temp = std::make_unique<sf::RenderTexture>();
+		temp->create(width, height);
+		temp->setSmooth(true);
+		bloomPyramidTemp.push_back(std::move(temp));
+	}
+}
+
+void RenderSystem::drawPyramidBloom(sf::RenderTexture& layerTexture, BloomSettings& settings) {
+	int levels = settings.getQuality();
+	createBloomPyramid(levels);
+
+	// Take the bright parts while downsampling to the first level
+	bloomDarkShader.setUniform("minBright", settings.getMinBright());
+	layerTexture.setSmooth(true);
+	{
+		sf::Sprite textureAsSprite(layerTexture.getTexture());
+		textureAsSprite.setScale((float)bloomPyramid[0]->getSize().x / layerTexture.getSize().x, (float)bloomPyramid[0]->getSize().y / layerTexture.getSize().y);
+
+		bloomPyramid[0]->clear(sf::Color::Transparent);
+		sf::RenderStates states;
+		states.shader = &bloomDarkShader;
+		states.blendMode = DEFAULT_BLEND_MODE;
+		bloomPyramid[0]->draw(textureAsSprite, states);
+		bloomPyramid[0]->display();
+	}
+	layerTexture.setSmooth(false);
+
+	// Downsample the rest of the levels
+	for (int k = 1; k < levels; k++) {
+		sf::Sprite textureAsSprite(bloomPyramid[k - 1]->getTexture());
+		textureAsSprite.setScale((float)bloomPyramid[k]->getSize().x / bloomPyramid[k - 1]->getSize().x, (float)bloomPyramid[k]->getSize().y / bloomPyramid[k - 1]->getSize().y);
+
+		bloomPyramid[k]->clear(sf::Color::Transparent);
+		bloomPyramid[k]->draw(textureAsSprite, sf::BlendNone);
+		bloomPyramid[k]->display();
+	}
+
+	// Blur from the smallest level up, adding each blurred level onto the level above it
+	for (int k = levels - 1; k >= 0; k--) {
+		sf::RenderTexture& level = *bloomPyramid[k];
+		sf::RenderTexture& temp = *bloomPyramidTemp[k];
+		// Blur the same distance in full resolution pixels as full resolution bloom does with 15 samples
+		int samples = std::max(1, (int)std::ceil(15.0f / (2 << k)));
+
+		for (int a = 0; a < bloomPyramidBlurShaders.size(); a++) {
+			sf::RenderTexture& source = (a % 2 == 0) ? level : temp;
+			sf::RenderTexture& dest = (a % 2 == 0) ? temp : level;
+
+			sf::Shader& shader = *bloomPyramidBlurShaders[a];
+			shader.setUniform("resolution", sf::Vector2f(source.getSize().x, source.getSize().y));
+			shader.setUniform("n", samples);
+
+			dest.clear(sf::Color::Transparent);
+			sf::RenderStates states;
+			states.shader = &shader;
+			states.blendMode = sf::BlendNone;
+			dest.draw(sf::Sprite(source.getTexture()), states);
+			dest.display();
+		}
+
+		if (k > 0) {
+			sf::Sprite textureAsSprite(level.getTexture());
+			textureAsSprite.setScale((float)bloomPyramid[k - 1]->getSize().x / level.getSize().x, (float)bloomPyramid[k - 1]->getSize().y / level.getSize().y);
+			bloomPyramid[k - 1]->draw(textureAsSprite, sf::BlendAdd);
+			bloomPyramid[k - 1]->display();
+		}
+	}
+
+	bloomGlowShader.setUniform("strength", settings.getGlowStrength());
+	// draw blurred onto window
+	sf::Sprite blurredAsSprite(bloomPyramid[0]->getTexture());
+	blurredAsSprite.setScale((float)layerTexture.getSize().x / bloomPyramid[0]->getSize().x, (float)layerTexture.getSize().y / bloomPyramid[0]->getSize().y);
+	sf::RenderStates states;
+	states.shader = &bloomGlowShader;
+	states.blendMode = sf::BlendAdd;
+	window.draw(blurredAsSprite, states);
+	// draw nonblurred onto window; the layer texture was never modified, so it doesn't need to be copied first
+	sf::Sprite nonblurredAsSprite(layerTexture.getTexture());
+	states.blendMode = settings.getBlendMode();
+	window.draw(nonblurredAsSprite, states);
+}
+
 void RenderSystem::loadLevelRenderSettings(std::shared_ptr<Level> level) {
 	if (level) {
 		bloom = std::vector<BloomSettings>(HIGHEST_RENDER_LAYER + 1, BloomSettings());
@@ -480,6 +643,15 @@ void RenderSystem::loadLevelRenderSettings(std::shared_ptr<Level> level) {
 			bloom[i] = bloomSettings;
 		}
 	}
+
+	// Free the layer textures of layers that no longer need them
+	for (auto it = layerTextures.begin(); it != layerTextures.end();) {
+		if (usesPostProcessing(it->first)) {
+			it++;
+		} else {
+			it = layerTextures.erase(it);
+		}
+	}
 }
 
 void RenderSystem::setBackground(sf::Texture background) {
@@ -499,6 +671,21 @@ sf::Vector2u RenderSystem::getResolution() {
 	return tempLayerTexture.getSize();
 }
 
+size_t RenderSystem::getRenderTargetMemoryUsage() const {
+	size_t pixels = (size_t)tempLayerTexture.getSize().x * tempLayerTexture.getSize().y;
+	for (auto& pair : layerTextures) {
+		pixels += (size_t)pair.second.getSize().x * pair.second.getSize().y;
+	}
+	for (auto& texture : bloomPyramid) {
+		pixels += (size_t)texture->getSize().x * texture->getSize().y;
+	}
+	for (auto& texture : bloomPyramidTemp) {
+		pixels += (size_t)texture->getSize().x * texture->getSize().y;
+	}
+	// 4 bytes (RGBA) per pixel
+	return pixels * 4;
+}
+
 std::shared_ptr<entt::SigH<void()>> RenderSystem::getOnResolutionChange() {
 	if (!onResolutionChange) {
 		onResolutionChange = std::make_shared<entt::SigH<void()>>();
@@ -510,7 +697,7 @@ std::string BloomSettings::format() const {
 	return formatBool(useBloom) + tos(glowStrength) + tos(minBright) + tos(static_cast<int>(blendMode.colorSrcFactor))
 		+ tos(static_cast<int>(blendMode.colorDstFactor)) + tos(static_cast<int>(blendMode.colorEquation))
 		+ tos(static_cast<int>(blendMode.alphaSrcFactor)) + tos(static_cast<int>(blendMode.alphaDstFactor))
-		+ tos(static_cast<int>(blendMode.alphaEquation));
+		+ tos(static_cast<int>(blendMode.alphaEquation)) + tos(static_cast<int>(quality));
 }
 
 void BloomSettings::load(std::string formattedString) {
@@ -529,4 +716,11 @@ void BloomSettings::load(std::string formattedString) {
 	blendMode.alphaSrcFactor = static_cast<sf::BlendMode::Factor>(std::stoi(items[6]));
 	blendMode.alphaDstFactor = static_cast<sf::BlendMode::Factor>(std::stoi(items[7]));
 	blendMode.alphaEquation = static_cast<sf::BlendMode::Equation>(std::stoi(items[8]));
+	// Settings saved before bloom quality existed use full resolution bloom
+	if (items.size() > 9) {
+		// Out of range values would make createBloomPyramid() loop forever
+		quality = static_cast<BLOOM_QUALITY>(std::max(static_cast<int>(BLOOM_FULL_RESOLUTION), std::min(std::stoi(items[9]), static_cast<int>(BLOOM_EIGHTH_RESOLUTION))));
+	} else {
+		quality = BLOOM_FULL_RESOLUTION;
+	}
 }
\ No newline at end of file
@@ -8,12 +8,29 @@
 #include <memory>
 #include "TextMarshallable.h"
 #include "SpriteLoader.h"
+#include "RenderQueue.h"
+#include "RenderSnapshot.h"
 
 class Level;
 
 // Default blend mode
 static sf::BlendMode DEFAULT_BLEND_MODE = sf::BlendMode(sf::BlendMode::Factor::SrcAlpha, sf::BlendMode::Factor::OneMinusSrcAlpha, sf::BlendMode::Equation::Add, sf::BlendMode::Factor::SrcAlpha, sf::BlendMode::Factor::OneMinusSrcAlpha, sf::BlendMode::Equation::Add);
 
+/*
+How a layer's bloom is blurred, from best-looking to fastest.
+The value of each is the number of downsampled textures the bloom is blurred on.
+*/
+enum BLOOM_QUALITY {
+	// Blur at full resolution
+	BLOOM_FULL_RESOLUTION = 0,
+	// Blur at half resolution
+	BLOOM_HALF_RESOLUTION = 1,
+	// Blur at half and quarter resolution
+	BLOOM_QUARTER_RESOLUTION = 2,
+	// Blur at half, quarter, and eighth resolution
+	BLOOM_EIGHTH_RESOLUTION = 3
+};
+
 class BloomSettings : public TextMarshallable {
 public:
 	inline BloomSettings() {}
@@ -27,11 +44,13 @@ public:
 	inline float getGlowStrength() { return glowStrength; }
 	inline float getMinBright() { return minBright; }
 	inline sf::BlendMode getBlendMode() { return blendMode; }
+	inline BLOOM_QUALITY getQuality() { return quality; }
 
 	inline void setUsesBloom(bool useBloom) { this->useBloom = useBloom; }
 	inline float setGlowStrength(float glowStrength) { this->glowStrength = glowStrength; }
 	inline float setMinBright(float minBright) { this->minBright = minBright; }
 	inline sf::BlendMode setBlendMode(sf::BlendMode blendMode) { this->blendMode = blendMode; }
+	inline void setQuality(BLOOM_QUALITY quality) { this->quality = quality; }
 
 private:
 	bool useBloom = false;
@@ -42,6 +61,8 @@ private:
 	float minBright;
 	// blend mode used when drawing the unblurred texture; saved as an int
 	sf::BlendMode blendMode = DEFAULT_BLEND_MODE;
+	// saved as an int
+	BLOOM_QUALITY quality = BLOOM_FULL_RESOLUTION;
 };
 
 /*
@@ -55,9 +76,24 @@ public:
 
 	background - the background of the map
 	*/
-	RenderSystem(entt::DefaultRegistry& registry, sf::RenderWindow& window, SpriteLoader& spriteLoader, float resolutionMultiplier = 1.0f, bool initShaders = true);
+	RenderSystem(entt::DefaultRegistry& registry, sf::RenderWindow& window, float resolutionMultiplier = 1.0f, bool initShaders = true);
+	/*
+	Draws the current state of the registry.
+	Same as taking a snapshot, building its batches, and drawing them.
+	*/
 	virtual void update(float deltaTime);
 
+	/*
+	Copies every sprite to be drawn from the registry into a snapshot, in the order they are drawn.
+	Must be called from the thread that owns the registry.
+	*/
+	void takeSnapshot(RenderSnapshot& snapshot);
+	/*
+	Draws the background and batches built from a snapshot onto the window.
+	Must be called from the thread that owns the window.
+	*/
+	void draw(const RenderBatches& batches, float deltaTime);
+
 	/*
 	Load bloom shaders to match a level's bloom settings.
 	If level is a nullptr, no bloom settings are used.
@@ -68,39 +104,48 @@ public:
 	Sets the resolution of the game.
 	This doesn't change the size of the window. It only affects the gameplay quality.
 	Resolutions that are too small won't work. 1600x900, 1024x768, and anything higher will work.
+
+	Sprites are always drawn in map units and only the views and the transform onto the window change,
+	so no sprite has to be rescaled.
 	*/
-	virtual void setResolution(SpriteLoader& spriteLoader, float resolutionMultiplier);
+	virtual void setResolution(float resolutionMultiplier);
 	
 	void setBackground(sf::Texture background);
 	inline void setBackgroundScrollSpeedX(float backgroundScrollSpeedX) { this->backgroundScrollSpeedX = backgroundScrollSpeedX; }
 	inline void setBackgroundScrollSpeedY(float backgroundScrollSpeedY) { this->backgroundScrollSpeedY = backgroundScrollSpeedY; }
 	inline void setBackgroundTextureWidth(float backgroundTextureWidth) {
 		this->backgroundTextureWidth = backgroundTextureWidth;
-		backgroundSprite.setScale(MAP_WIDTH / backgroundTextureWidth * resolutionMultiplier, MAP_HEIGHT / backgroundTextureHeight * resolutionMultiplier);
+		backgroundSprite.setScale(MAP_WIDTH / backgroundTextureWidth, MAP_HEIGHT / backgroundTextureHeight);
 	}
 	inline void setBackgroundTextureHeight(float backgroundTextureHeight) {
 		this->backgroundTextureHeight = backgroundTextureHeight;
-		backgroundSprite.setScale(MAP_WIDTH / backgroundTextureWidth * resolutionMultiplier, MAP_HEIGHT / backgroundTextureHeight * resolutionMultiplier);
+		backgroundSprite.setScale(MAP_WIDTH / backgroundTextureWidth, MAP_HEIGHT / backgroundTextureHeight);
 	}
 
 	sf::Vector2u getResolution();
+	/*
+	Returns the number of sprites that were not drawn in the last update because they were completely outside the play area.
+	*/
+	inline int getCulledSpritesCount() const { return culledSpritesCount; }
+	/*
+	Returns the video memory, in bytes, taken up by the render textures that currently exist at the current resolution.
+	Layer textures only exist for layers that have global shaders or bloom, so this changes with the loaded level.
+	*/
+	size_t getRenderTargetMemoryUsage() const;
 	std::shared_ptr<entt::SigH<void()>> getOnResolutionChange();
 
 protected:
 	entt::DefaultRegistry& registry;
 	sf::RenderWindow& window;
 
-	struct SubLayerComparator {
-		int operator()(const SpriteComponent& a, const SpriteComponent& b) {
-			return a.getSubLayer() < b.getSubLayer();
-		}
-	};
-
-	// Pairs of layer and entities in that layer
-	// Entites in the same layer are sorted by sublayer
-	std::vector<std::pair<int, std::vector<std::reference_wrapper<SpriteComponent>>>> layers;
+	// Sprites to be drawn this frame, sorted by layer and sublayer
+	RenderQueue renderQueue;
+	// Reused by update()
+	RenderSnapshot updateSnapshot;
+	RenderBatches updateBatches;
 	// Maps layer to the texture, onto which all sprites in a layer on drawn
 	// All textures are the same size
+	// Only layers with global shaders or bloom have a texture; it is created the first time the layer is drawn
 	std::map<int, sf::RenderTexture> layerTextures;
 	// Maps layer to the global shaders applied on that layer
 	std::map<int, std::vector<std::unique_ptr<sf::Shader>>> globalShaders;
@@ -113,12 +158,18 @@ protected:
 	sf::Shader bloomGlowShader;
 	// Shader used to darken textures before blurring them
 	sf::Shader bloomDarkShader;
+	// Shaders used to blur the textures in the bloom pyramid; their resolution changes with every texture
+	std::vector<std::unique_ptr<sf::Shader>> bloomPyramidBlurShaders;
+	// Textures for bloom that is not at full resolution; each is half the size of the one before it
+	// Created only when a layer needs them
+	std::vector<std::unique_ptr<sf::RenderTexture>> bloomPyramid;
+	// Temporary textures for blurring each texture in bloomPyramid
+	std::vector<std::unique_ptr<sf::RenderTexture>> bloomPyramidTemp;
 
 	// Temporary layer texture for using multiple shaders
 	sf::RenderTexture tempLayerTexture;
-	sf::RenderTexture tempLayerTexture2;
-	// Temporary layer texture just for the background
-	sf::RenderTexture backgroundTempLayerTexture;
+	// Transform from map units to where the layer textures are drawn onto the window, for drawing sprites directly onto the window
+	sf::Transform layerToWindowTransform;
 
 	// Black magic needed to scale texture conversion into sprites correctly since views do not match the texture size
 	// I actually don't know why this is needed only when using 2 or more global shaders on a texture
@@ -137,4 +188,36 @@ protected:
 	float backgroundTextureSizeX, backgroundTextureSizeY;
 
 	std::shared_ptr<entt::SigH<void()>> onResolutionChange;
+
+	int culledSpritesCount = 0;
+
+	/*
+	Draws a batch onto a render target.
+	*/
+	void drawBatch(sf::RenderTarget& target, const RenderBatches& batches, const RenderBatch& batch, const sf::Transform& transform);
+	/*
+	Returns the texture of a layer, creating it if it doesn't exist yet.
+	*/
+	sf::RenderTexture& getLayerTexture(int layer);
+	/*
+	Returns whether a layer has global shaders or bloom, in which case it must be drawn onto its layer texture first.
+	*/
+	bool usesPostProcessing(int layer);
+	/*
+	Applies every global shader of a layer to its layer texture.
+	Returns the texture that the result is in.
+	*/
+	sf::RenderTexture& applyGlobalShaders(int layer);
+	/*
+	Creates the first levels textures of the bloom pyramid, if they don't exist yet.
+	*/
+	void createBloomPyramid(int levels);
+	/*
+	Draws a layer with bloom that is blurred on the bloom pyramid instead of at full resolution.
+	The bright parts of the layer are taken once while downsampling, then each level is blurred and added to
+	the level above it, from the smallest level up.
+
+	layerTexture - the texture with the layer's sprites drawn on it; not modified
+	*/
+	void drawPyramidBloom(sf::RenderTexture& layerTexture, BloomSettings& settings);
 };
\ No newline at end of file
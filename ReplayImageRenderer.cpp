@@ -0,0 +1,122 @@
+#include "ReplayImageRenderer.h"
+#include <algorithm>
+#include "LevelPack.h"
+#include "Level.h"
+#include "Player.h"
+#include "Components.h"
+#include "Constants.h"
+
+ReplayImageRenderer::ReplayImageRenderer(std::string levelPackName, float resolutionMultiplier) {
+	audioPlayer = std::make_unique<AudioPlayer>();
+	levelPack = std::make_unique<LevelPack>(*audioPlayer, levelPackName);
+
+	queue = std::make_unique<EntityCreationQueue>(registry);
+	spriteLoader = levelPack->createSpriteLoader(false);
+
+	movementSystem = std::make_unique<MovementSystem>(*queue, *spriteLoader, registry);
+	collisionSystem = std::make_unique<CollisionSystem>(*levelPack, *queue, *spriteLoader, registry, MAP_WIDTH, MAP_HEIGHT);
+	despawnSystem = std::make_unique<DespawnSystem>(registry);
+	enemySystem = std::make_unique<EnemySystem>(*queue, *spriteLoader, *levelPack, registry);
+	spriteAnimationSystem = std::make_unique<SpriteAnimationSystem>(*spriteLoader, registry);
+	shadowTrailSystem = std::make_unique<ShadowTrailSystem>(*queue, registry);
+	playerSystem = std::make_unique<PlayerSystem>(*levelPack, *queue, *spriteLoader, registry);
+	collectibleSystem = std::make_unique<CollectibleSystem>(*queue, registry, MAP_WIDTH, MAP_HEIGHT);
+	softwareRenderSystem = std::make_unique<SoftwareRenderSystem>(registry, *spriteLoader, resolutionMultiplier);
+}
+
+sf::Image ReplayImageRenderer::render(const Replay& replay) {
+	loadLevel(replay);
+	for (int i = 0; i < replay.getFramesCount(); i++) {
+		auto frame = replay.getFrame(i);
+		physicsUpdate(frame.first, frame.second);
+	}
+	// Sprite animations are advanced by rendering, which is not part of the replay, so only rotations are applied
+	spriteAnimationSystem->update(0);
+
+	softwareRenderSystem->update(0);
+	return softwareRenderSystem->getImage();
+}
+
+GOLDEN_IMAGE_RESULT ReplayImageRenderer::compareToGoldenImage(const Replay& replay, const std::string& goldenImageFileName, int& differentPixels, int tolerance) {
+	differentPixels = 0;
+	sf::Image image = render(replay);
+	sf::Image goldenImage;
+	if (!goldenImage.loadFromFile(goldenImageFileName)) {
+		if (!image.saveToFile(goldenImageFileName)) {
+			return GOLDEN_IMAGE_WRITE_FAILED;
+		}
+		return GOLDEN_IMAGE_WRITTEN;
+	}
+
+	int count = SoftwareRenderSystem::countDifferentPixels(image, goldenImage, tolerance);
+	if (count == -1) {
+		return GOLDEN_IMAGE_SIZE_MISMATCH;
+	}
+	differentPixels = count;
+	return count == 0 ? GOLDEN_IMAGE_MATCH : GOLDEN_IMAGE_DIFFERENT;
+}
+
+void ReplayImageRenderer::loadLevel(const Replay& replay) {
+	std::shared_ptr<Level> level = levelPack->getLevel(replay.getLevelIndex());
+
+	const LevelProfile& levelProfile = levelPack->getLevelProfile(level);
+	collisionSystem->loadLevelProfile(levelProfile);
+	collectibleSystem->loadLevelProfile(levelProfile);
+	movementSystem->setCullingMargin(level->getCullingMargin());
+
+	registry.reset();
+	reserveMemory(registry, std::max(INITIAL_ENTITY_RESERVATION, levelProfile.expectedPeakEntityCount));
+
+	registry.reserve<LevelManagerTag>(1);
+	registry.reserve(registry.alive() + 1);
+	uint32_t levelManager = registry.create();
+	registry.assign<LevelManagerTag>(entt::tag_t{}, levelManager, &(*levelPack), level, replay.getRandomSeed());
+
+	createPlayer(*levelPack->getPlayer());
+}
+
+void ReplayImageRenderer::createPlayer(EditorPlayer params) {
+	registry.reserve(1);
+	registry.reserve<PlayerTag>(1);
+	registry.reserve<AnimatableSetComponent>(1);
+	registry.reserve<HealthComponent>(1);
+	registry.reserve<HitboxComponent>(1);
+	registry.reserve<PositionComponent>(1);
+	registry.reserve<SpriteComponent>(1);
+
+	auto player = registry.create();
+	registry.assign<AnimatableSetComponent>(player);
+	registry.assign<PlayerTag>(entt::tag_t{}, player, registry, *levelPack, player, params.getSpeed(), params.getFocusedSpeed(), params.getInvulnerabilityTime(),
+		params.getPowerTiers(), params.getHurtSound(), params.getDeathSound(), params.getInitialBombs(), params.getMaxBombs(), params.getBombInvincibilityTime());
+	registry.assign<HealthComponent>(player, params.getInitialHealth(), params.getMaxHealth());
+	// Hitbox temporarily at 0, 0 until an Animatable is assigned to the player later
+	registry.assign<HitboxComponent>(player, LOCK_ROTATION, params.getHitboxRadius(), 0, 0);
+	registry.assign<PositionComponent>(player, PLAYER_SPAWN_X - params.getHitboxPosX(), PLAYER_SPAWN_Y - params.getHitboxPosY());
+	registry.assign<SpriteComponent>(player, PLAYER_LAYER, 0);
+}
+
+void ReplayImageRenderer::physicsUpdate(float deltaTime, InputFrame input) {
+	collisionSystem->update(deltaTime);
+	queue->executeAll();
+
+	registry.get<LevelManagerTag>().update(*queue, *spriteLoader, registry, deltaTime);
+	queue->executeAll();
+
+	despawnSystem->update(deltaTime);
+	queue->executeAll();
+
+	shadowTrailSystem->update(deltaTime);
+	queue->executeAll();
+
+	movementSystem->update(deltaTime);
+	queue->executeAll();
+
+	collectibleSystem->update(deltaTime);
+	queue->executeAll();
+
+	playerSystem->update(deltaTime, input);
+	queue->executeAll();
+
+	enemySystem->update(deltaTime);
+	queue->executeAll();
+}
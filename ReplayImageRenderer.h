@@ -0,0 +1,80 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <entt/entt.hpp>
+#include <memory>
+#include <string>
+#include "MovementSystem.h"
+#include "CollisionSystem.h"
+#include "EnemySystem.h"
+#include "DespawnSystem.h"
+#include "SpriteAnimationSystem.h"
+#include "EntityCreationQueue.h"
+#include "ShadowTrailSystem.h"
+#include "PlayerSystem.h"
+#include "CollectibleSystem.h"
+#include "SoftwareRenderSystem.h"
+#include "AudioPlayer.h"
+#include "PlayerInput.h"
+
+class LevelPack;
+class EditorPlayer;
+
+enum GOLDEN_IMAGE_RESULT {
+	// The image matched the golden image within the tolerance
+	GOLDEN_IMAGE_MATCH,
+	// Some pixels differed from the golden image by more than the tolerance
+	GOLDEN_IMAGE_DIFFERENT,
+	// The image is not the same size as the golden image
+	GOLDEN_IMAGE_SIZE_MISMATCH,
+	// There was no golden image, so it was created from the image
+	GOLDEN_IMAGE_WRITTEN,
+	// There was no golden image and it could not be created
+	GOLDEN_IMAGE_WRITE_FAILED
+};
+
+/*
+Plays replays without a window, a gui, or an OpenGL context and draws their last update with a SoftwareRenderSystem,
+so that the image only depends on the replay and not on the GPU.
+Only the systems that affect physics are run. Sprites come from a SpriteLoader that doesn't create textures.
+*/
+class ReplayImageRenderer {
+public:
+	ReplayImageRenderer(std::string levelPackName, float resolutionMultiplier = 1.0f);
+
+	/*
+	Plays a replay from the start of its level as fast as possible and returns the image of the last update.
+	*/
+	sf::Image render(const Replay& replay);
+	/*
+	Compares the image from render() to a golden image file. If the golden image file doesn't exist yet,
+	it is created from the image instead.
+
+	differentPixels - set to the number of pixels that differ by more than tolerance in any channel; 0 unless the images are compared
+	*/
+	GOLDEN_IMAGE_RESULT compareToGoldenImage(const Replay& replay, const std::string& goldenImageFileName, int& differentPixels, int tolerance = 0);
+
+private:
+	std::unique_ptr<AudioPlayer> audioPlayer;
+	std::unique_ptr<LevelPack> levelPack;
+	std::unique_ptr<SpriteLoader> spriteLoader;
+	std::unique_ptr<EntityCreationQueue> queue;
+
+	entt::DefaultRegistry registry;
+
+	std::unique_ptr<MovementSystem> movementSystem;
+	std::unique_ptr<CollisionSystem> collisionSystem;
+	std::unique_ptr<DespawnSystem> despawnSystem;
+	std::unique_ptr<EnemySystem> enemySystem;
+	std::unique_ptr<SpriteAnimationSystem> spriteAnimationSystem;
+	std::unique_ptr<ShadowTrailSystem> shadowTrailSystem;
+	std::unique_ptr<PlayerSystem> playerSystem;
+	std::unique_ptr<CollectibleSystem> collectibleSystem;
+	std::unique_ptr<SoftwareRenderSystem> softwareRenderSystem;
+
+	/*
+	Removes every entity and starts the replay's level with the replay's random seed.
+	*/
+	void loadLevel(const Replay& replay);
+	void createPlayer(EditorPlayer params);
+	void physicsUpdate(float deltaTime, InputFrame input);
+};
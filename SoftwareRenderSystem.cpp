@@ -0,0 +1,182 @@
+#include "SoftwareRenderSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Returns the value of a blend factor for one channel, with all colors in the range [0, 1]
+static float getBlendFactor(sf::BlendMode::Factor factor, const float source[4], const float destination[4], int channel) {
+	switch (factor) {
+	case sf::BlendMode::Zero:
+		return 0;
+	case sf::BlendMode::One:
+		return 1;
+	case sf::BlendMode::SrcColor:
+		return source[channel];
+	case sf::BlendMode::OneMinusSrcColor:
+		return 1 - source[channel];
+	case sf::BlendMode::DstColor:
+		return destination[channel];
+	case sf::BlendMode::OneMinusDstColor:
+		return 1 - destination[channel];
+	case sf::BlendMode::SrcAlpha:
+		return source[3];
+	case sf::BlendMode::OneMinusSrcAlpha:
+		return 1 - source[3];
+	case sf::BlendMode::DstAlpha:
+		return destination[3];
+	case sf::BlendMode::OneMinusDstAlpha:
+		return 1 - destination[3];
+	}
+	return 1;
+}
+
+static float applyBlendEquation(sf::BlendMode::Equation equation, float source, float destination) {
+	switch (equation) {
+	case sf::BlendMode::Subtract:
+		return source - destination;
+	case sf::BlendMode::ReverseSubtract:
+		return destination - source;
+	default:
+		return source + destination;
+	}
+}
+
+SoftwareRenderSystem::SoftwareRenderSystem(entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, float resolutionMultiplier) : registry(registry), spriteLoader(spriteLoader) {
+	setResolution(resolutionMultiplier);
+}
+
+void SoftwareRenderSystem::update(float deltaTime) {
+	renderQueue.clear();
+
+	sf::FloatRect playArea(0, -MAP_HEIGHT, MAP_WIDTH, MAP_HEIGHT);
+	culledSpritesCount = 0;
+	drawnSpritesCount = 0;
+
+	auto view = registry.view<PositionComponent, SpriteComponent>(entt::persistent_t{});
+	view.each([&](auto entity, auto& position, auto& sprite) {
+		if (sprite.getSprite()) {
+			sprite.getSprite()->setPosition(position.getX(), -position.getY());
+			if (!playArea.intersects(sprite.getSprite()->getGlobalBounds())) {
+				culledSpritesCount++;
+				return;
+			}
+			renderQueue.push(sprite);
+		}
+	});
+	renderQueue.sort();
+
+	sf::Vector2u size = image.getSize();
+	image.create(size.x, size.y, clearColor);
+
+	for (std::size_t i = 0; i < renderQueue.size(); i++) {
+		drawSprite(*renderQueue.getSprite(i).getSprite(), sf::BlendAlpha);
+	}
+}
+
+void SoftwareRenderSystem::setResolution(float resolutionMultiplier) {
+	this->resolutionMultiplier = resolutionMultiplier;
+
+	int newPlayAreaWidth = (int)std::round(MAP_WIDTH * resolutionMultiplier);
+	int newPlayAreaHeight = (int)std::round(MAP_HEIGHT * resolutionMultiplier);
+	image.create(newPlayAreaWidth, newPlayAreaHeight, clearColor);
+	// Same as RenderSystem's transform from map units onto the window
+	mapToImageTransform = sf::Transform().scale((float)newPlayAreaWidth / MAP_WIDTH, (float)newPlayAreaHeight / MAP_HEIGHT).translate(0, MAP_HEIGHT);
+}
+
+int SoftwareRenderSystem::countDifferentPixels(const sf::Image& a, const sf::Image& b, int tolerance) {
+	if (a.getSize() != b.getSize()) {
+		return -1;
+	}
+
+	const sf::Uint8* aPixels = a.getPixelsPtr();
+	const sf::Uint8* bPixels = b.getPixelsPtr();
+	int count = 0;
+	std::size_t pixelsCount = (std::size_t)a.getSize().x * a.getSize().y;
+	for (std::size_t i = 0; i < pixelsCount; i++) {
+		for (int channel = 0; channel < 4; channel++) {
+			if (std::abs(aPixels[i * 4 + channel] - bPixels[i * 4 + channel]) > tolerance) {
+				count++;
+				break;
+			}
+		}
+	}
+	return count;
+}
+
+SoftwareRenderSystem::TextureSource SoftwareRenderSystem::getTextureSource(const sf::Sprite& sprite) {
+	const sf::Texture* texture = sprite.getTexture();
+	if (texture) {
+		auto it = textureSources.find(texture);
+		if (it != textureSources.end()) {
+			return it->second;
+		}
+	}
+
+	TextureSource source;
+	if (!spriteLoader.getImageSource(sprite, source.image, source.texturePosition, source.area)) {
+		source.image = nullptr;
+	}
+	if (texture) {
+		textureSources.emplace(texture, source);
+	}
+	return source;
+}
+
+void SoftwareRenderSystem::drawSprite(const sf::Sprite& sprite, const sf::BlendMode& blendMode) {
+	TextureSource source = getTextureSource(sprite);
+	if (!source.image) {
+		return;
+	}
+	drawnSpritesCount++;
+
+	sf::IntRect textureRect = sprite.getTextureRect();
+	float localWidth = std::abs(textureRect.width);
+	float localHeight = std::abs(textureRect.height);
+	sf::Color color = sprite.getColor();
+	// From image pixels to the sprite's local coordinates
+	sf::Transform inverse = (mapToImageTransform * sprite.getTransform()).getInverse();
+
+	sf::FloatRect bounds = mapToImageTransform.transformRect(sprite.getGlobalBounds());
+	int minX = std::max(0, (int)std::floor(bounds.left));
+	int maxX = std::min((int)image.getSize().x, (int)std::ceil(bounds.left + bounds.width));
+	int minY = std::max(0, (int)std::floor(bounds.top));
+	int maxY = std::min((int)image.getSize().y, (int)std::ceil(bounds.top + bounds.height));
+
+	for (int y = minY; y < maxY; y++) {
+		for (int x = minX; x < maxX; x++) {
+			// Sample at the center of the pixel
+			sf::Vector2f local = inverse.transformPoint(x + 0.5f, y + 0.5f);
+			if (local.x < 0 || local.y < 0 || local.x >= localWidth || local.y >= localHeight) {
+				continue;
+			}
+
+			// Texture rects with negative sizes are flipped
+			int u = (int)std::floor(textureRect.left + local.x * (textureRect.width / localWidth));
+			int v = (int)std::floor(textureRect.top + local.y * (textureRect.height / localHeight));
+			u = std::min(std::max(source.texturePosition.x + u, source.area.left), source.area.left + source.area.width - 1);
+			v = std::min(std::max(source.texturePosition.y + v, source.area.top), source.area.top + source.area.height - 1);
+
+			sf::Color texel = source.image->getPixel(u, v);
+			image.setPixel(x, y, blend(texel * color, image.getPixel(x, y), blendMode));
+		}
+	}
+}
+
+sf::Color SoftwareRenderSystem::blend(sf::Color source, sf::Color destination, const sf::BlendMode& blendMode) {
+	float src[4] = { source.r / 255.0f, source.g / 255.0f, source.b / 255.0f, source.a / 255.0f };
+	float dst[4] = { destination.r / 255.0f, destination.g / 255.0f, destination.b / 255.0f, destination.a / 255.0f };
+
+	sf::Uint8 result[4];
+	for (int channel = 0; channel < 4; channel++) {
+		float value;
+		if (channel < 3) {
+			value = applyBlendEquation(blendMode.colorEquation, src[channel] * getBlendFactor(blendMode.colorSrcFactor, src, dst, channel),
+				dst[channel] * getBlendFactor(blendMode.colorDstFactor, src, dst, channel));
+		} else {
+			value = applyBlendEquation(blendMode.alphaEquation, src[channel] * getBlendFactor(blendMode.alphaSrcFactor, src, dst, channel),
+				dst[channel] * getBlendFactor(blendMode.alphaDstFactor, src, dst, channel));
+		}
+		result[channel] = (sf::Uint8)std::round(std::min(1.0f, std::max(0.0f, value)) * 255);
+	}
+	return sf::Color(result[0], result[1], result[2], result[3]);
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <entt/entt.hpp>
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <map>
+#include <memory>
+#include "Components.h"
+#include "SpriteLoader.h"
+#include "RenderQueue.h"
+
+/*
+Render system that draws onto an sf::Image entirely on the CPU.
+Meant to be the reference that changes to RenderSystem are compared against and benchmarked with on machines without a GPU.
+
+Sprites are culled, ordered, and positioned the same way RenderSystem does it, and are drawn with their texture rect,
+transform, color, and blend mode. Sprite shaders, global shaders, bloom, and the background are not drawn, since
+they all need the GPU.
+Textures are never read; sprites are sampled (nearest-neighbor, like unsmoothed textures) from the sprite sheet
+images that the SpriteLoader decoded. With a SpriteLoader that doesn't create textures, no OpenGL context is needed,
+as long as no sprite effect animation loads a shader.
+*/
+class SoftwareRenderSystem {
+public:
+	SoftwareRenderSystem(entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, float resolutionMultiplier = 1.0f);
+	void update(float deltaTime);
+
+	/*
+	Sets the resolution of the image that is drawn on, the same way as RenderSystem::setResolution.
+	Sprites are drawn in map units, so none of them are rescaled.
+	*/
+	void setResolution(float resolutionMultiplier);
+	inline void setClearColor(sf::Color clearColor) { this->clearColor = clearColor; }
+
+	/*
+	Returns the image drawn on in the last update.
+	*/
+	inline const sf::Image& getImage() const { return image; }
+	inline sf::Vector2u getResolution() const { return image.getSize(); }
+	/*
+	Returns the number of sprites that were not drawn in the last update because they were completely outside the play area.
+	*/
+	inline int getCulledSpritesCount() const { return culledSpritesCount; }
+	inline int getDrawnSpritesCount() const { return drawnSpritesCount; }
+
+	/*
+	Returns the number of pixels that differ between two images by more than some tolerance in any channel,
+	or -1 if the images are not the same size.
+	*/
+	static int countDifferentPixels(const sf::Image& a, const sf::Image& b, int tolerance = 0);
+
+private:
+	struct TextureSource {
+		// nullptr if the sprite did not come from the SpriteLoader
+		std::shared_ptr<sf::Image> image;
+		// Position in the image of texture coordinates (0, 0)
+		sf::Vector2i texturePosition;
+		// Area of the image that the texture covers
+		sf::IntRect area;
+	};
+
+	entt::DefaultRegistry& registry;
+	SpriteLoader& spriteLoader;
+	float resolutionMultiplier = 1.0f;
+
+	sf::Image image;
+	sf::Color clearColor = sf::Color::Black;
+	// Transform from map units to image pixels
+	sf::Transform mapToImageTransform;
+
+	// Sorted the same way as in RenderSystem so that sprites are drawn in the same order
+	RenderQueue renderQueue;
+	// Maps a texture to where it was loaded from
+	// Cached because finding it means searching every texture of every sprite sheet; sprites without textures are not cached
+	std::map<const sf::Texture*, TextureSource> textureSources;
+
+	int culledSpritesCount = 0;
+	int drawnSpritesCount = 0;
+
+	TextureSource getTextureSource(const sf::Sprite& sprite);
+	void drawSprite(const sf::Sprite& sprite, const sf::BlendMode& blendMode);
+	/*
+	Returns the result of blending a color onto another, as the GPU would.
+	*/
+	static sf::Color blend(sf::Color source, sf::Color destination, const sf::BlendMode& blendMode);
+};
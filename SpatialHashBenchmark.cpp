@@ -0,0 +1,111 @@
+#include "SpatialHashBenchmark.h"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include "HierarchicalSpatialHashTable.h"
+#include "Constants.h"
+
+/*
+Appends the index of every candidate bullet that actually collides with the hitbox, sorted and without duplicates.
+*/
+static void addCollisions(const std::vector<uint32_t>& candidates, const HitboxComponent& hitbox, const PositionComponent& position,
+	const std::vector<HitboxComponent>& bulletHitboxes, const std::vector<PositionComponent>& bulletPositions, std::vector<uint32_t>& dest) {
+	std::size_t start = dest.size();
+	for (uint32_t bullet : candidates) {
+		float dx = (position.getX() + hitbox.getX()) - (bulletPositions[bullet].getX() + bulletHitboxes[bullet].getX());
+		float dy = (position.getY() + hitbox.getY()) - (bulletPositions[bullet].getY() + bulletHitboxes[bullet].getY());
+		float radii = hitbox.getRadius() + bulletHitboxes[bullet].getRadius();
+		if (dx * dx + dy * dy <= radii * radii) {
+			dest.push_back(bullet);
+		}
+	}
+	std::sort(dest.begin() + start, dest.end());
+	dest.erase(std::unique(dest.begin() + start, dest.end()), dest.end());
+}
+
+SpatialHashBenchmarkResult benchmarkSpatialHashTables(int bulletsCount, int largeBulletsCount, float largeBulletRadius, int lookupsCount, int updatesCount, unsigned int seed) {
+	SpatialHashBenchmarkResult result;
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> randomX(0, MAP_WIDTH);
+	std::uniform_real_distribution<float> randomY(0, MAP_HEIGHT);
+	std::uniform_real_distribution<float> randomBulletRadius(2, 10);
+	std::uniform_real_distribution<float> randomLookupRadius(5, 30);
+
+	// Same sizes CollisionSystem used before the hierarchical table
+	float defaultTableObjectMaxSize = 2.0f * std::max(MAP_WIDTH, MAP_HEIGHT) / 10.0f;
+	SpatialHashTable<uint32_t> fixedGrid(MAP_WIDTH, MAP_HEIGHT, defaultTableObjectMaxSize / 2.0f);
+	SpatialHashTable<uint32_t> largeFixedGrid(MAP_WIDTH, MAP_HEIGHT, std::max(largeBulletRadius, 10.0f) * 2.0f);
+	HierarchicalSpatialHashTable<uint32_t> hierarchical(MAP_WIDTH, MAP_HEIGHT, SMALLEST_COLLISION_CELL_SIZE, std::max(largeBulletRadius, 10.0f));
+
+	std::vector<HitboxComponent> bulletHitboxes;
+	std::vector<PositionComponent> bulletPositions;
+	std::vector<HitboxComponent> lookupHitboxes;
+	std::vector<PositionComponent> lookupPositions;
+	std::vector<uint32_t> candidates;
+	std::vector<uint32_t> fixedGridsCollisions;
+	std::vector<uint32_t> hierarchicalCollisions;
+	std::chrono::duration<double, std::micro> fixedGridsTime(0);
+	std::chrono::duration<double, std::micro> hierarchicalTime(0);
+
+	for (int update = 0; update < updatesCount; update++) {
+		bulletHitboxes.clear();
+		bulletPositions.clear();
+		for (int i = 0; i < bulletsCount; i++) {
+			float radius = (i < largeBulletsCount) ? largeBulletRadius : randomBulletRadius(random);
+			bulletHitboxes.push_back(HitboxComponent(LOCK_ROTATION, radius, 0, 0));
+			bulletPositions.push_back(PositionComponent(randomX(random), randomY(random)));
+		}
+		lookupHitboxes.clear();
+		lookupPositions.clear();
+		for (int i = 0; i < lookupsCount; i++) {
+			lookupHitboxes.push_back(HitboxComponent(LOCK_ROTATION, randomLookupRadius(random), 0, 0));
+			lookupPositions.push_back(PositionComponent(randomX(random), randomY(random)));
+		}
+
+		fixedGridsCollisions.clear();
+		auto start = std::chrono::steady_clock::now();
+		fixedGrid.clear();
+		largeFixedGrid.clear();
+		for (int i = 0; i < bulletsCount; i++) {
+			if (bulletHitboxes[i].getRadius() < defaultTableObjectMaxSize) {
+				fixedGrid.insert(i, bulletHitboxes[i], bulletPositions[i]);
+			} else {
+				largeFixedGrid.insert(i, bulletHitboxes[i], bulletPositions[i]);
+			}
+		}
+		for (int i = 0; i < lookupsCount; i++) {
+			candidates.clear();
+			fixedGrid.getNearbyObjects(lookupHitboxes[i], lookupPositions[i], candidates);
+			largeFixedGrid.getNearbyObjects(lookupHitboxes[i], lookupPositions[i], candidates);
+			result.fixedGridsCandidates += candidates.size();
+			addCollisions(candidates, lookupHitboxes[i], lookupPositions[i], bulletHitboxes, bulletPositions, fixedGridsCollisions);
+		}
+		fixedGridsTime += std::chrono::steady_clock::now() - start;
+
+		hierarchicalCollisions.clear();
+		start = std::chrono::steady_clock::now();
+		hierarchical.clear();
+		for (int i = 0; i < bulletsCount; i++) {
+			hierarchical.insert(i, bulletHitboxes[i], bulletPositions[i]);
+		}
+		for (int i = 0; i < lookupsCount; i++) {
+			candidates.clear();
+			hierarchical.getNearbyObjects(lookupHitboxes[i], lookupPositions[i], candidates);
+			result.hierarchicalCandidates += candidates.size();
+			addCollisions(candidates, lookupHitboxes[i], lookupPositions[i], bulletHitboxes, bulletPositions, hierarchicalCollisions);
+		}
+		hierarchicalTime += std::chrono::steady_clock::now() - start;
+
+		if (fixedGridsCollisions != hierarchicalCollisions) {
+			result.sameCollisions = false;
+		}
+	}
+
+	if (updatesCount > 0) {
+		result.fixedGridsTime = (float)(fixedGridsTime.count() / updatesCount);
+		result.hierarchicalTime = (float)(hierarchicalTime.count() / updatesCount);
+	}
+	return result;
+}
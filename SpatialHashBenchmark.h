@@ -0,0 +1,27 @@
+#pragma once
+
+/*
+Timing of what CollisionSystem does with its bullet tables every update: inserting every bullet
+and then looking up the bullets near some hitboxes, like the player's and the enemies'.
+*/
+struct SpatialHashBenchmarkResult {
+	// Average time per update, in microseconds
+	float fixedGridsTime = 0;
+	float hierarchicalTime = 0;
+	// Total number of bullets returned by every lookup over every update, including duplicates
+	long long fixedGridsCandidates = 0;
+	long long hierarchicalCandidates = 0;
+	// Whether both found exactly the same colliding bullets in every lookup
+	bool sameCollisions = true;
+};
+
+/*
+Compares a HierarchicalSpatialHashTable to the two fixed grids it replaced in CollisionSystem: one for bullets smaller than
+a tenth of the map, and one with cells as wide as the largest bullet. Bullets and lookups are placed randomly in the map
+from a fixed seed, so runs with the same arguments time the same work.
+
+bulletsCount - bullets inserted every update
+largeBulletsCount - how many of those bullets have largeBulletRadius instead of a radius between 2 and 10
+lookupsCount - hitboxes, with a radius between 5 and 30, looked up every update
+*/
+SpatialHashBenchmarkResult benchmarkSpatialHashTables(int bulletsCount, int largeBulletsCount, float largeBulletRadius, int lookupsCount, int updatesCount, unsigned int seed = 0);
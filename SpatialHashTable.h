@@ -19,9 +19,9 @@ class SpatialHashTable {
 public:
 	inline SpatialHashTable() {}
 	inline SpatialHashTable(float mapWidth, float mapHeight, float cellSize) : mapWidth(mapWidth), mapHeight(mapHeight), cellSize(cellSize) {
-		buckets = std::vector<std::vector<T>>(int(ceil(mapWidth / cellSize)) * int(ceil(mapHeight / cellSize)));
-		cellsPerMapWidth = int(mapWidth / cellSize);
-		cellsPerMapHeight = int(mapHeight / cellSize);
+		cellsPerMapWidth = int(ceil(mapWidth / cellSize));
+		cellsPerMapHeight = int(ceil(mapHeight / cellSize));
+		buckets = std::vector<std::vector<T>>(cellsPerMapWidth * cellsPerMapHeight);
 	}
 
 	inline void clear() {
@@ -30,10 +30,20 @@ public:
 		}
 	}
 
-	inline void insert(T object, float hitboxX, float hitboxY, float hitboxRadius, const PositionComponent& position) {
+	/*
+	Returns false if the object was not inserted because it is completely outside the map.
+	*/
+	inline bool insert(T object, float hitboxX, float hitboxY, float hitboxRadius, const PositionComponent& position) {
+		// Objects completely outside the map are deliberately dropped; getNearbyObjects() would otherwise
+		// clamp them into the edge cells, where they could never collide with anything on the map
+		if (position.getX() + hitboxX + hitboxRadius < 0 || position.getX() + hitboxX - hitboxRadius > mapWidth
+			|| position.getY() + hitboxY + hitboxRadius < 0 || position.getY() + hitboxY - hitboxRadius > mapHeight) {
+			return false;
+		}
+
 		int leftmostXCell = std::max(0, (int)((position.getX() + hitboxX - hitboxRadius) / cellSize));
-		int rightmostXCell = std::min(cellsPerMapWidth, (int)((position.getX() + hitboxX + hitboxRadius) / cellSize));
-		int topmostYCell = std::min(cellsPerMapHeight, (int)((position.getY() + hitboxY + hitboxRadius) / cellSize));
+		int rightmostXCell = std::min(cellsPerMapWidth - 1, (int)((position.getX() + hitboxX + hitboxRadius) / cellSize));
+		int topmostYCell = std::min(cellsPerMapHeight - 1, (int)((position.getY() + hitboxY + hitboxRadius) / cellSize));
 		int bottommostYCell = std::max(0, (int)((position.getY() + hitboxY - hitboxRadius) / cellSize));
 		
 		for (int xCell = leftmostXCell; xCell <= rightmostXCell; xCell++) {
@@ -41,28 +51,39 @@ public:
 				buckets[xCell + yCell * cellsPerMapWidth].push_back(object);
 			}
 		}
+		return true;
 	}
 
-	inline void insert(T object, const HitboxComponent& hitbox, const PositionComponent& position) {
-		insert(object, hitbox.getX(), hitbox.getY(), hitbox.getRadius(), position);
+	inline bool insert(T object, const HitboxComponent& hitbox, const PositionComponent& position) {
+		return insert(object, hitbox.getX(), hitbox.getY(), hitbox.getRadius(), position);
 	}
 
 	inline std::vector<T> getNearbyObjects(const HitboxComponent& hitbox, const PositionComponent& position) {
+		std::vector<T> all;
+		getNearbyObjects(hitbox, position, all);
+		return all;
+	}
+
+	/*
+	Appends the objects in every cell that overlaps the hitbox to dest.
+	An object that is in multiple of those cells is appended once for each of them.
+	*/
+	inline void getNearbyObjects(const HitboxComponent& hitbox, const PositionComponent& position, std::vector<T>& dest) {
 		int leftmostXCell = std::max(0, (int)((position.getX() + hitbox.getX() - hitbox.getRadius()) / cellSize));
-		int rightmostXCell = std::min(cellsPerMapWidth, (int)((position.getX() + hitbox.getX() + hitbox.getRadius()) / cellSize));
-		int topmostYCell = std::min(cellsPerMapHeight, (int)((position.getY() + hitbox.getY() + hitbox.getRadius()) / cellSize));
+		int rightmostXCell = std::min(cellsPerMapWidth - 1, (int)((position.getX() + hitbox.getX() + hitbox.getRadius()) / cellSize));
+		int topmostYCell = std::min(cellsPerMapHeight - 1, (int)((position.getY() + hitbox.getY() + hitbox.getRadius()) / cellSize));
 		int bottommostYCell = std::max(0, (int)((position.getY() + hitbox.getY() - hitbox.getRadius()) / cellSize));
 
-		std::vector<T> all;
 		for (int xCell = leftmostXCell; xCell <= rightmostXCell; xCell++) {
 			for (int yCell = bottommostYCell; yCell <= topmostYCell; yCell++) {
 				int i = xCell + yCell * cellsPerMapWidth;
-				all.insert(all.end(), buckets[i].begin(), buckets[i].end());
+				dest.insert(dest.end(), buckets[i].begin(), buckets[i].end());
 			}
 		}
-		return all;
 	}
 
+	inline float getCellSize() const { return cellSize; }
+
 private:
 	float mapWidth;
 	float mapHeight;
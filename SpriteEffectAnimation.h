@@ -18,6 +18,13 @@ public:
 	*/
 	inline SpriteEffectAnimation(std::shared_ptr<sf::Sprite> sprite) : sprite(sprite) {}
 	virtual void update(float deltaTime) = 0;
+	/*
+	Returns a copy of this SEA, including its progress, that modifies a different sprite.
+	sf::Shader is not copyable, so any shader is loaded again.
+
+	sprite - the pointer to the sprite that the copy will modify
+	*/
+	virtual std::unique_ptr<SpriteEffectAnimation> clone(std::shared_ptr<sf::Sprite> sprite) const = 0;
 
 	bool usesShader() { return useShader; }
 	sf::Shader& getShader() { return shader; }
@@ -60,6 +67,12 @@ public:
 	}
 
 	void update(float deltaTime) override;
+	inline std::unique_ptr<SpriteEffectAnimation> clone(std::shared_ptr<sf::Sprite> sprite) const override {
+		auto copy = std::make_unique<FlashWhiteSEA>(sprite, animationDuration, flashInterval, flashDuration);
+		copy->time = time;
+		copy->done = done;
+		return std::move(copy);
+	}
 
 private:
 	float flashInterval;
@@ -84,6 +97,11 @@ public:
 	}
 
 	void update(float deltaTime) override;
+	inline std::unique_ptr<SpriteEffectAnimation> clone(std::shared_ptr<sf::Sprite> sprite) const override {
+		auto copy = std::make_unique<FadeAwaySEA>(sprite, minOpacity, maxOpacity, animationDuration);
+		copy->time = time;
+		return std::move(copy);
+	}
 
 private:
 	float minOpacity;
@@ -108,6 +126,11 @@ public:
 	}
 
 	void update(float deltaTime) override;
+	inline std::unique_ptr<SpriteEffectAnimation> clone(std::shared_ptr<sf::Sprite> sprite) const override {
+		auto copy = std::make_unique<ChangeSizeSEA>(sprite, startScale, endScale, animationDuration);
+		copy->time = time;
+		return std::move(copy);
+	}
 
 private:
 	float startScale;
@@ -7,6 +7,7 @@
 #include <regex>
 #include <sstream>
 #include <limits>
+#include <future>
 
 static const std::string SPRITE_SHEET_NAME_TAG = "SpriteSheetName";
 static const std::string SPRITE_TOPLEFT_COORDS_TAG = "TextureTopLeftCoordinates";
@@ -40,21 +41,25 @@ std::shared_ptr<sf::Sprite> SpriteSheet::getSprite(const std::string& spriteName
 	std::shared_ptr<SpriteData> data = spriteData.at(spriteName);
 	ComparableIntRect area = data->getArea();
 
-	// Texture has not been loaded yet
-	if (textures.find(area) == textures.end()) {
-		// Load texture
-		std::shared_ptr<sf::Texture> texture = std::make_shared<sf::Texture>();
-		texture->loadFromImage(*image, area);
-
-		// Insert texture into map
-		textures[area] = texture;
-	}
-
 	// Create sprite
 	std::shared_ptr<sf::Sprite> sprite = std::make_shared<sf::Sprite>();
-	sprite->setTexture(*textures[area]);
+	if (createTextures) {
+		// Texture has not been loaded yet
+		if (textures.find(area) == textures.end()) {
+			// Load texture
+			std::shared_ptr<sf::Texture> texture = std::make_shared<sf::Texture>();
+			texture->loadFromImage(*image, area);
+
+			// Insert texture into map
+			textures[area] = texture;
+		}
+		sprite->setTexture(*textures[area]);
+	} else {
+		sprite->setTextureRect(sf::IntRect(area.left, area.top + textureRectOffsetY, area.width, area.height));
+	}
 	sprite->setColor(data->getColor());
-	sprite->setScale((float)data->getSpriteWidth() / area.width * globalSpriteScale, (float)data->getSpriteHeight() / area.height * globalSpriteScale);
+	// Sprites are sized in map units; the render system scales them to the resolution
+	sprite->setScale((float)data->getSpriteWidth() / area.width, (float)data->getSpriteHeight() / area.height);
 	sprite->setOrigin(data->getSpriteOriginX(), data->getSpriteOriginY());
 	return sprite;
 }
@@ -97,24 +102,59 @@ void SpriteSheet::preloadTextures() {
 	}
 }
 
-void SpriteSheet::setGlobalSpriteScale(float scale) {
-	globalSpriteScale = scale;
-	for (auto it = spriteData.begin(); it != spriteData.end(); it++) {
-		ComparableIntRect area = it->second->getArea();
-		getSprite(it->first)->setScale((float)it->second->getSpriteWidth() / area.width * globalSpriteScale, (float)it->second->getSpriteHeight() / area.height * globalSpriteScale);
+void SpriteSheet::disableTextures(int textureRectOffsetY) {
+	createTextures = false;
+	this->textureRectOffsetY = textureRectOffsetY;
+}
 
+bool SpriteSheet::getImageSource(const sf::Sprite& sprite, std::shared_ptr<sf::Image>& image, sf::Vector2i& texturePosition, sf::IntRect& area) const {
+	if (createTextures) {
+		for (auto it = textures.begin(); it != textures.end(); it++) {
+			if (it->second.get() == sprite.getTexture()) {
+				image = this->image;
+				texturePosition = sf::Vector2i(it->first.left, it->first.top);
+				area = it->first;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	sf::IntRect textureRect = sprite.getTextureRect();
+	if (sprite.getTexture() || textureRect.top < textureRectOffsetY || textureRect.top >= textureRectOffsetY + (int)this->image->getSize().y) {
+		return false;
 	}
+	image = this->image;
+	texturePosition = sf::Vector2i(0, -textureRectOffsetY);
+	area = sf::IntRect(textureRect.left, textureRect.top - textureRectOffsetY, textureRect.width, textureRect.height);
+	return true;
 }
 
 bool SpriteData::operator==(const SpriteData & other) const {
 	return this->area == other.area && this->color == other.color;
 }
 
-SpriteLoader::SpriteLoader(const std::string& levelPackRelativePath, const std::vector<std::pair<std::string, std::string>>& spriteSheetNamePairs) : levelPackRelativePath(levelPackRelativePath) {
+SpriteLoader::SpriteLoader(const std::string& levelPackRelativePath, const std::vector<std::pair<std::string, std::string>>& spriteSheetNamePairs, bool createTextures) : levelPackRelativePath(levelPackRelativePath) {
+	ScopedLoadStageTimer totalTimer(loadTimeReport, "Load all sprite sheets");
+
+	// Sprite sheets don't depend on each other, so decode all of them at the same time
+	std::vector<std::future<std::shared_ptr<SpriteSheet>>> sheetTasks;
 	for (std::pair<std::string, std::string> namesPair : spriteSheetNamePairs) {
-		if (!loadSpriteSheet(namesPair.first, namesPair.second)) {
-			throw "Unable to load sprite sheet meta file \"" + namesPair.first + "\" and/or sprite sheet \"" + namesPair.second + "\"";
+		sheetTasks.push_back(std::async(std::launch::async, &SpriteLoader::loadSpriteSheet, this, namesPair.first, namesPair.second));
+	}
+
+	// Without textures, the sprite sheet images are stacked vertically so that every texture rect belongs to one of them
+	int textureRectOffsetY = 0;
+	for (int i = 0; i < sheetTasks.size(); i++) {
+		std::shared_ptr<SpriteSheet> sheet = sheetTasks[i].get();
+		if (!sheet) {
+			throw "Unable to load sprite sheet meta file \"" + spriteSheetNamePairs[i].first + "\" and/or sprite sheet \"" + spriteSheetNamePairs[i].second + "\"";
+		}
+		if (!createTextures) {
+			sheet->disableTextures(textureRectOffsetY);
+			textureRectOffsetY += sheet->getImageSize().y;
 		}
+		spriteSheets[sheet->getName()] = sheet;
 	}
 }
 
@@ -131,6 +171,7 @@ std::unique_ptr<Animation> SpriteLoader::getAnimation(const std::string & animat
 }
 
 void SpriteLoader::preloadTextures() {
+	ScopedLoadStageTimer timer(loadTimeReport, "Upload textures");
 	for (auto it = spriteSheets.begin(); it != spriteSheets.end(); it++) {
 		it->second->preloadTextures();
 	}
@@ -140,29 +181,35 @@ void SpriteLoader::clearSpriteSheets() {
 	spriteSheets.clear();
 }
 
-void SpriteLoader::setGlobalSpriteScale(float scale) {
+bool SpriteLoader::getImageSource(const sf::Sprite& sprite, std::shared_ptr<sf::Image>& image, sf::Vector2i& texturePosition, sf::IntRect& area) const {
 	for (auto it = spriteSheets.begin(); it != spriteSheets.end(); it++) {
-		it->second->setGlobalSpriteScale(scale);
+		if (it->second->getImageSource(sprite, image, texturePosition, area)) {
+			return true;
+		}
 	}
+	return false;
 }
 
-bool SpriteLoader::loadSpriteSheet(const std::string& spriteSheetMetaFileName, const std::string& spriteSheetImageFileName) {
+std::shared_ptr<SpriteSheet> SpriteLoader::loadSpriteSheet(const std::string& spriteSheetMetaFileName, const std::string& spriteSheetImageFileName) {
+	ScopedLoadStageTimer timer(loadTimeReport, "Load sprite sheet " + spriteSheetMetaFileName);
+
 	std::ifstream metafile(levelPackRelativePath + "\\" + spriteSheetMetaFileName);
 	if (!metafile) {
-		return false;
+		return nullptr;
 	}
 
 	// Make sure image file exists
 	struct stat buffer;
 	if (!stat((levelPackRelativePath + "\\" + spriteSheetImageFileName).c_str(), &buffer) == 0) {
 		metafile.close();
-		return false;
+		return nullptr;
 	}
 
+	std::shared_ptr<SpriteSheet> sheet;
 	try {
 		// Sprite sheet name is the name of the meta file without the extension
 		std::string spriteSheetName = spriteSheetMetaFileName.substr(0, spriteSheetMetaFileName.find_last_of("."));
-		std::shared_ptr<SpriteSheet> sheet = std::make_shared<SpriteSheet>(spriteSheetName);
+		sheet = std::make_shared<SpriteSheet>(spriteSheetName);
 
 		std::unique_ptr<std::map<std::string, std::unique_ptr<std::map<std::string, std::string>>>> metadata = TextFileParser(metafile).read('=');
 		for (auto animationIterator = metadata->begin(); animationIterator != metadata->end(); animationIterator++) {
@@ -266,20 +313,19 @@ bool SpriteLoader::loadSpriteSheet(const std::string& spriteSheetMetaFileName, c
 		}
 
 		// Load image file
+		ScopedLoadStageTimer decodeTimer(loadTimeReport, "Decode image " + spriteSheetImageFileName);
 		if (!sheet->loadImage(levelPackRelativePath + "\\" + spriteSheetImageFileName)) {
 			throw "Image file \"" + levelPackRelativePath + "\\" + spriteSheetImageFileName + "\" could not be loaded";
 		}
-
-		spriteSheets[spriteSheetName] = sheet;
 	}
 	catch (std::exception e) {
 		BOOST_LOG_TRIVIAL(error) << "Invalid format in \"" + spriteSheetMetaFileName + "\"; " + e.what();
 		metafile.close();
-		return false;
+		return nullptr;
 	}
 	metafile.close();
 
-	return true;
+	return sheet;
 }
 
 bool AnimationData::operator==(const AnimationData & other) const {
@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include "Animation.h"
+#include "LoadTimeReport.h"
 
 /*
 The only purpose of this class is to have an IntRect that can be used as a key for maps
@@ -63,14 +64,26 @@ private:
 class SpriteSheet {
 public:
 	inline SpriteSheet(std::string name) : name(name) {}
+	inline std::string getName() const { return name; }
 	std::shared_ptr<sf::Sprite> getSprite(const std::string& spriteName);
 	std::unique_ptr<Animation> getAnimation(const std::string& animationName, bool loop);
 	void insertSprite(const std::string&, std::shared_ptr<SpriteData>);
 	void insertAnimation(const std::string&, std::shared_ptr<AnimationData>);
 	bool loadImage(const std::string& imageFileName);
 	void preloadTextures();
-	// Scale all sprites by the same amount
-	void setGlobalSpriteScale(float scale);
+	/*
+	Stops textures from being created. Sprites created afterwards have no texture, and their texture rects are the
+	areas of the image they come from, moved down by textureRectOffsetY so that sprites from different sprite sheets
+	can be told apart.
+	*/
+	void disableTextures(int textureRectOffsetY);
+	inline sf::Vector2u getImageSize() const { return image->getSize(); }
+	/*
+	Finds the area of this sprite sheet's image that a sprite is drawn from.
+	Returns false if the sprite was not created by this sprite sheet.
+	See SpriteLoader::getImageSource().
+	*/
+	bool getImageSource(const sf::Sprite& sprite, std::shared_ptr<sf::Image>& image, sf::Vector2i& texturePosition, sf::IntRect& area) const;
 
 	inline const std::map<std::string, std::shared_ptr<SpriteData>> getSpriteData() { return spriteData; }
 	inline const std::map<std::string, std::shared_ptr<AnimationData>> getAnimationData() { return animationData; }
@@ -79,6 +92,9 @@ private:
 	// Name of the sprite sheet
 	std::string name;
 	std::shared_ptr<sf::Image> image;
+	bool createTextures = true;
+	// Only used if createTextures is false
+	int textureRectOffsetY = 0;
 	// Maps an area on the image to a Texture
 	std::map<ComparableIntRect, std::shared_ptr<sf::Texture>> textures;
 	// Maps a sprite name to SpriteData
@@ -87,8 +103,6 @@ private:
 	std::map<std::string, std::shared_ptr<AnimationData>> animationData;
 	// Maps an animation name to a list of pairs of sprites and for how long each sprite appears for
 	std::map<std::string, std::vector<std::pair<float, std::shared_ptr<sf::Sprite>>>> animationSprites;
-
-	float globalSpriteScale = 1.0f;
 };
 
 /*
@@ -96,8 +110,15 @@ Note that if the SpriteLoader object goes out of scope, all Sprites loaded from
 */
 class SpriteLoader {
 public:
-	// spriteSheetNames - vector of pairs of SpriteSheet meta file names and SpriteSheet image file names
-	SpriteLoader(const std::string& levelPackRelativePath, const std::vector<std::pair<std::string, std::string>>& spriteSheetNamePairs);
+	/*
+	Sprite sheets are loaded concurrently. Textures are not created until they are needed
+	or until preloadTextures() is called, which must be done from the thread that will be drawing the sprites.
+
+	spriteSheetNames - vector of pairs of SpriteSheet meta file names and SpriteSheet image file names
+	createTextures - if false, no textures are ever created, so no OpenGL context is needed. The sprites then have no
+		texture and can only be drawn by a SoftwareRenderSystem.
+	*/
+	SpriteLoader(const std::string& levelPackRelativePath, const std::vector<std::pair<std::string, std::string>>& spriteSheetNamePairs, bool createTextures = true);
 
 	/*
 	Returns an entirely new sf::Sprite.
@@ -105,16 +126,37 @@ public:
 	std::shared_ptr<sf::Sprite> getSprite(const std::string& spriteName, const std::string& spriteSheetName);
 	std::unique_ptr<Animation> getAnimation(const std::string& animationName, const std::string& spriteSheetName, bool loop);
 	inline const std::map<std::string, std::shared_ptr<SpriteSheet>> getSpriteSheets() { return spriteSheets; }
+	/*
+	Creates the textures of every sprite in every sprite sheet.
+	*/
 	void preloadTextures();
 	void clearSpriteSheets();
-	// Scale all sprites by the same amount
-	void setGlobalSpriteScale(float scale);
+	/*
+	Finds the sprite sheet image that a sprite is drawn from, so that it can be drawn without
+	reading its texture back from the GPU or, if textures are not created, without a texture at all.
+	Returns false if the sprite was not created by this SpriteLoader.
+
+	texturePosition - set to the position in the image of the sprite's texture coordinates (0, 0)
+	area - set to the area of the image that the sprite's texture covers
+	*/
+	bool getImageSource(const sf::Sprite& sprite, std::shared_ptr<sf::Image>& image, sf::Vector2i& texturePosition, sf::IntRect& area) const;
+	/*
+	Returns the durations of loading each sprite sheet and of the last preloadTextures() call.
+	*/
+	inline const LoadTimeReport& getLoadTimeReport() const { return loadTimeReport; }
 
 private:
 	// Relative path to the level path containing the files
 	std::string levelPackRelativePath;
 	// Maps SpriteSheet name (as specified in the meta file) to SpriteSheet
 	std::map<std::string, std::shared_ptr<SpriteSheet>> spriteSheets;
-	// Returns true if the meta file and image file were successfully loaded
-	bool loadSpriteSheet(const std::string& spriteSheetMetaFileName, const std::string& spriteSheetImageFileName);
+	// Durations of each stage of loading the sprite sheets
+	LoadTimeReport loadTimeReport;
+	/*
+	Parses the meta file and decodes the image file of a sprite sheet.
+	Safe to call from multiple threads at once.
+
+	Returns the sprite sheet, or nullptr if the meta file or image file could not be loaded
+	*/
+	std::shared_ptr<SpriteSheet> loadSpriteSheet(const std::string& spriteSheetMetaFileName, const std::string& spriteSheetImageFileName);
 };
\ No newline at end of file
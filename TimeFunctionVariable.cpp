@@ -179,6 +179,49 @@ float PiecewiseTFV::evaluate(float time) {
 	}
 }
 
+bool PiecewiseTFV::isNondecreasing(float fromTime, float toTime) {
+	if (segments.size() == 0) {
+		return false;
+	}
+	for (int i = 0; i < segments.size(); i++) {
+		float segmentStart = (i == 0) ? std::min(fromTime, segments[0].first) : segments[i].first;
+		float segmentEnd = (i + 1 < segments.size()) ? segments[i + 1].first : std::max(toTime, segmentStart);
+		if (segmentEnd < fromTime || segmentStart > toTime) {
+			continue;
+		}
+		if (!segments[i].second->isNondecreasing(std::max(fromTime, segmentStart) - segments[i].first, std::min(toTime, segmentEnd) - segments[i].first)) {
+			return false;
+		}
+		// The next segment must not start lower than where this one ends
+		if (i + 1 < segments.size() && segmentEnd <= toTime
+			&& segments[i + 1].second->evaluate(0) < segments[i].second->evaluate(segmentEnd - segments[i].first)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PiecewiseTFV::isConstant(float fromTime, float toTime) {
+	if (segments.size() == 0) {
+		return false;
+	}
+	for (int i = 0; i < segments.size(); i++) {
+		float segmentStart = (i == 0) ? std::min(fromTime, segments[0].first) : segments[i].first;
+		float segmentEnd = (i + 1 < segments.size()) ? segments[i + 1].first : std::max(toTime, segmentStart);
+		if (segmentEnd < fromTime || segmentStart > toTime) {
+			continue;
+		}
+		if (!segments[i].second->isConstant(std::max(fromTime, segmentStart) - segments[i].first, std::min(toTime, segmentEnd) - segments[i].first)) {
+			return false;
+		}
+		if (i + 1 < segments.size() && segmentEnd <= toTime
+			&& segments[i + 1].second->evaluate(0) != segments[i].second->evaluate(segmentEnd - segments[i].first)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 std::pair<float, int> PiecewiseTFV::piecewiseEvaluate(float time) {
 	int l = 0;
 	int h = segments.size(); // Not n - 1
@@ -32,6 +32,17 @@ public:
 
 	virtual float evaluate(float time) = 0;
 
+	/*
+	Returns true if it can be proven that the value of this TFV never decreases from fromTime to toTime.
+	False only means that it could not be proven.
+	*/
+	virtual bool isNondecreasing(float fromTime, float toTime) { return false; }
+	/*
+	Returns true if it can be proven that the value of this TFV does not change from fromTime to toTime.
+	False only means that it could not be proven.
+	*/
+	virtual bool isConstant(float fromTime, float toTime) { return false; }
+
 protected:
 	// The lifespan of the TFV
 	// Note that some types of TFVs don't need to know its own lifespan for evaluation
@@ -58,6 +69,8 @@ public:
 	inline float evaluate(float time) {
 		return startValue + (time / maxTime) * (endValue - startValue);
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override { return endValue >= startValue; }
+	inline bool isConstant(float fromTime, float toTime) override { return endValue == startValue; }
 
 	inline float getStartValue() { return startValue; }
 	inline float getEndValue() { return endValue; }
@@ -87,6 +100,8 @@ public:
 	inline float evaluate(float time) {
 		return value;
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override { return true; }
+	inline bool isConstant(float fromTime, float toTime) override { return true; }
 
 	inline void setValue(float value) { this->value = value; }
 	inline float getValue() { return value; }
@@ -117,6 +132,8 @@ public:
 	inline float evaluate(float time) {
 		return amplitude * (float)sin(time * PI2 / period + phaseShift) + valueShift;
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override { return amplitude == 0; }
+	inline bool isConstant(float fromTime, float toTime) override { return amplitude == 0; }
 
 	inline void setPeriod(float period) { this->period = period; }
 	inline void setAmplitude(float amplitude) { this->amplitude = amplitude; }
@@ -154,6 +171,11 @@ public:
 	inline float evaluate(float time) override {
 		return initialDistance + initialVelocity * time + 0.5f*acceleration*time*time;
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override {
+		// Velocity is linear in time, so it is nonnegative over the whole range if it is at both ends
+		return initialVelocity + acceleration * fromTime >= 0 && initialVelocity + acceleration * toTime >= 0;
+	}
+	inline bool isConstant(float fromTime, float toTime) override { return initialVelocity == 0 && acceleration == 0; }
 
 	inline void setInitialDistance(float initialDistance) { this->initialDistance = initialDistance; }
 	inline void setInitialVelocity(float initialVelocity) { this->initialVelocity = initialVelocity; }
@@ -193,6 +215,7 @@ public:
 	inline float evaluate(float time) override {
 		return a * pow(time, 0.08f*dampeningFactor + 1) + startValue;
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override { return endValue >= startValue && fromTime >= 0 && toTime <= maxTime; }
 
 	inline void setStartValue(float startValue) {
 		this->startValue = startValue;
@@ -246,6 +269,7 @@ public:
 	inline float evaluate(float time) override {
 		return -a * pow(maxTime - time, 0.08f*dampeningFactor + 1) + endValue;
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override { return endValue >= startValue && fromTime >= 0 && toTime <= maxTime; }
 
 	inline void setStartValue(float startValue) {
 		this->startValue = startValue;
@@ -304,6 +328,7 @@ public:
 			return -a * pow(maxTime - time, 0.08f*dampeningFactor + 1) + endValue;
 		}
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override { return endValue >= startValue && fromTime >= 0 && toTime <= maxTime; }
 
 	inline void setStartValue(float startValue) {
 		this->startValue = startValue;
@@ -354,6 +379,8 @@ public:
 	inline float evaluate(float time) override {
 		return valueTranslation + wrappedTFV->evaluate(time);
 	}
+	inline bool isNondecreasing(float fromTime, float toTime) override { return wrappedTFV->isNondecreasing(fromTime, toTime); }
+	inline bool isConstant(float fromTime, float toTime) override { return wrappedTFV->isConstant(fromTime, toTime); }
 
 private:
 	std::shared_ptr<TFV> wrappedTFV;
@@ -428,6 +455,8 @@ public:
 	}
 
 	float evaluate(float time) override;
+	bool isNondecreasing(float fromTime, float toTime) override;
+	bool isConstant(float fromTime, float toTime) override;
 
 	/*
 	Returns a pair containing, in order, the normal evaluation of the TFV and the index of the segment
@@ -1,31 +1,78 @@
 #pragma once
 #include <deque>
 #include <functional>
+#include <string>
+#include <chrono>
+#include <algorithm>
 
 class UndoableCommand {
 public:
-	inline UndoableCommand(std::function<void()> command, std::function<void()> reverse) : command(command), reverse(reverse) {}
+	/*
+	command - executes the command
+	reverse - undoes the command
+	memoryUsage - estimated number of bytes of state captured by command and reverse, such as copies of edited objects.
+		Objects that will be needed regardless of the undo history, like the object being edited, should not be counted.
+		Captured strings and containers can be estimated by their capacity, TextMarshallables by the size of their
+		formatted string, and anything else by its sizeof.
+	coalesceKey - consecutive commands with the same nonempty coalesceKey executed in quick succession are merged
+		into one (see UndoStack::execute()). It should identify both the object and the property being edited.
+	*/
+	inline UndoableCommand(std::function<void()> command, std::function<void()> reverse, size_t memoryUsage = 0, std::string coalesceKey = "") :
+		command(command), reverse(reverse), memoryUsage(memoryUsage), coalesceKey(coalesceKey) {}
 
 	inline void execute() { command(); }
 	inline void undo() { reverse(); }
 
+	/*
+	Returns the estimated number of bytes used by this command, including itself.
+	*/
+	inline size_t getMemoryUsage() const { return sizeof(UndoableCommand) + coalesceKey.capacity() + memoryUsage; }
+
 private:
 	std::function<void()> command;
 	std::function<void()> reverse;
+	size_t memoryUsage;
+	std::string coalesceKey;
+	// When this command was last executed by an UndoStack
+	std::chrono::steady_clock::time_point executionTime;
+
+	friend class UndoStack;
 };
 
+/*
+Commands are removed, oldest first, whenever there are more than maxCommands of them or
+they use more than maxMemoryUsage bytes in total. The next command to be undone and the next
+command to be redone are never removed.
+*/
 class UndoStack {
 public:
-	inline UndoStack(int maxCommands) : maxCommands(maxCommands) {};
+	inline UndoStack(int maxCommands, size_t maxMemoryUsage = DEFAULT_MAX_MEMORY_USAGE) : maxCommands(maxCommands), maxMemoryUsage(maxMemoryUsage) {};
 
+	/*
+	Executes a command and adds it to the undo stack.
+	If the command has the same nonempty coalesce key as the last command executed and comes within COALESCE_WINDOW of it,
+	the two are merged, so that a single undo reverts both. This keeps a slider being dragged from filling the
+	undo stack with every intermediate value.
+	*/
 	inline void execute(UndoableCommand command) {
 		command.execute();
+		command.executionTime = std::chrono::steady_clock::now();
 
-		undoStack.push_front(command);
-		if (undoStack.size() > maxCommands) {
-			undoStack.pop_back();
+		clearRedoStack();
+		if (!command.coalesceKey.empty() && undoStack.size() > 0 && undoStack.front().coalesceKey == command.coalesceKey
+			&& command.executionTime - undoStack.front().executionTime <= COALESCE_WINDOW) {
+			// Keep the reverse of the first command so that undoing goes back to before all of them
+			UndoableCommand& last = undoStack.front();
+			memoryUsage -= last.getMemoryUsage();
+			last.command = command.command;
+			last.memoryUsage = std::max(last.memoryUsage, command.memoryUsage);
+			last.executionTime = command.executionTime;
+			memoryUsage += last.getMemoryUsage();
+		} else {
+			memoryUsage += command.getMemoryUsage();
+			undoStack.push_front(command);
 		}
-		redoStack.clear();
+		trim();
 	}
 
 	inline void undo() {
@@ -33,37 +80,69 @@ public:
 			undoStack.front().undo();
 
 			redoStack.push_front(undoStack.front());
-			if (redoStack.size() > maxCommands) {
-				redoStack.pop_back();
-			}
-
 			undoStack.pop_front();
+			trim();
 		}
 	}
 
 	inline void redo() {
 		if (redoStack.size() > 0) {
 			redoStack.front().execute();
+			// A redone command should not be merged with the next one
+			redoStack.front().executionTime = std::chrono::steady_clock::time_point();
 
 			undoStack.push_front(redoStack.front());
-			if (undoStack.size() > maxCommands) {
-				undoStack.pop_back();
-			}
-			
 			redoStack.pop_front();
+			trim();
 		}
 	}
 
 	inline void clear() {
 		undoStack.clear();
 		redoStack.clear();
+		memoryUsage = 0;
 	}
 
+	/*
+	Returns the estimated number of bytes used by all commands in the undo and redo stacks.
+	*/
+	inline size_t getMemoryUsage() const { return memoryUsage; }
+
 private:
-	// Maximum number of commands stored in the UndoStack
+	const static size_t DEFAULT_MAX_MEMORY_USAGE = 16 * 1024 * 1024;
+	// Maximum time between two commands for them to be merged
+	const std::chrono::milliseconds COALESCE_WINDOW = std::chrono::milliseconds(1000);
+
+	// Maximum number of commands stored in each of the undo and redo stacks
 	int maxCommands;
+	// Maximum number of bytes used by the commands in both stacks
+	size_t maxMemoryUsage;
+	// Number of bytes used by the commands in both stacks
+	size_t memoryUsage = 0;
 
 	// New commands pushed to front
 	std::deque<UndoableCommand> undoStack;
 	std::deque<UndoableCommand> redoStack;
-};
\ No newline at end of file
+
+	inline void clearRedoStack() {
+		for (const UndoableCommand& command : redoStack) {
+			memoryUsage -= command.getMemoryUsage();
+		}
+		redoStack.clear();
+	}
+
+	/*
+	Removes the oldest commands until the limits are satisfied.
+	The last commands to be redone go first, then the oldest commands to be undone.
+	*/
+	inline void trim() {
+		while (redoStack.size() > maxCommands || (memoryUsage > maxMemoryUsage && redoStack.size() > 1)) {
+			memoryUsage -= redoStack.back().getMemoryUsage();
+			redoStack.pop_back();
+		}
+		while (undoStack.size() > maxCommands || (memoryUsage > maxMemoryUsage && undoStack.size() > 1)) {
+			memoryUsage -= undoStack.back().getMemoryUsage();
+			undoStack.pop_back();
+		}
+	}
+};